@@ -0,0 +1,108 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <imgui.h>
+#include <imgui-file_browser.hpp>
+
+namespace benchmark
+{
+	using clock_type = std::chrono::steady_clock;
+
+	[[nodiscard]] inline auto to_milliseconds(const clock_type::duration duration) noexcept -> double
+	{
+		return std::chrono::duration<double, std::milli>(duration).count();
+	}
+
+	// the median of the runs, the first runs warm the page cache / the allocator
+	[[nodiscard]] inline auto median(std::vector<double> values) noexcept -> double
+	{
+		std::ranges::sort(values);
+		return values[values.size() / 2];
+	}
+
+	constexpr int default_runs = 5;
+
+	// argv[1] if given, the number of entries of the generated directories
+	[[nodiscard]] inline auto entry_count(const int argc, char** argv, const std::size_t default_count) noexcept -> std::size_t
+	{
+		return argc > 1 ? static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10)) : default_count;
+	}
+
+	// count empty files named make_name(0 ~ count - 1) in the temporary directory, reused by the next runs (a ".complete" marker is written last)
+	[[nodiscard]] inline auto make_directory(
+		const std::string_view name,
+		const std::size_t count,
+		const std::function<auto(std::size_t index) -> std::string>& make_name
+	) noexcept -> std::filesystem::path
+	{
+		auto directory = std::filesystem::temp_directory_path() / std::format("imfb_benchmark_{}_{}", name, count);
+
+		if (exists(directory / ".complete"))
+		{
+			return directory;
+		}
+
+		std::printf("creating %zu files in %s...\n", count, directory.string().c_str());
+
+		std::error_code error_code{};
+		remove_all(directory, error_code);
+		create_directories(directory);
+
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			std::ofstream{directory / make_name(i)};
+		}
+		std::ofstream{directory / ".complete"};
+
+		return directory;
+	}
+
+	// ImGui without a backend, the draw data is built but never rendered
+	class HeadlessContext final
+	{
+	public:
+		HeadlessContext(const HeadlessContext&) noexcept = delete;
+		HeadlessContext(HeadlessContext&&) noexcept = delete;
+		auto operator=(const HeadlessContext&) noexcept -> HeadlessContext& = delete;
+		auto operator=(HeadlessContext&&) noexcept -> HeadlessContext& = delete;
+
+		HeadlessContext() noexcept
+		{
+			ImGui::CreateContext();
+
+			auto& io = ImGui::GetIO();
+			io.IniFilename = nullptr;
+			io.DisplaySize = ImVec2{1920, 1080};
+			io.DeltaTime = 1.0f / 60;
+
+			// NewFrame requires the font atlas to be built
+			unsigned char* pixels = nullptr;
+			int width = 0;
+			int height = 0;
+			io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+		}
+
+		~HeadlessContext() noexcept
+		{
+			ImGui::DestroyContext();
+		}
+
+		// one frame with the file browser shown
+		auto frame(ImGui::FileBrowser& file_browser) const noexcept -> void
+		{
+			ImGui::NewFrame();
+			file_browser.show();
+			ImGui::Render();
+		}
+	};
+}
@@ -0,0 +1,183 @@
+// the synchronous listing of a large directory (FileBrowserFlags::NONE)
+// the previous FileBrowser::update_file_descriptors (directory_iterator + is_regular_file / is_directory, a path / path / string descriptor per entry, a lowercase copy of both names on each compare) against FileBrowser::set_working_directory
+// usage: IMFB_BENCHMARK_enumerate [entries = 100000], the 1M entries of the original measurement take a while to create (tmpfs recommended for TMPDIR)
+
+#include <benchmark.hpp>
+
+#include <cctype>
+#include <ranges>
+
+namespace
+{
+	// the previous FileBrowser::file_descriptor
+	struct file_descriptor
+	{
+		std::filesystem::path name;
+		std::filesystem::path extension;
+
+		std::string display_name;
+		bool is_directory;
+	};
+
+	// the loop of the previous FileBrowser::update_file_descriptors
+	auto previous_enumerate(const std::filesystem::path& directory, std::vector<file_descriptor>& file_descriptors) noexcept -> void
+	{
+		file_descriptors.clear();
+
+		// parent folder
+		file_descriptors.push_back({.name = "..", .extension = "", .display_name = std::string{ImGui::FileBrowser::parent_path_name}, .is_directory = true});
+
+		std::error_code error_code{};
+		auto directory_iterator = std::filesystem::directory_iterator{directory, error_code};
+
+		if (error_code)
+		{
+			return;
+		}
+
+		std::string tooltip{"Error occurred\n"};
+
+		std::ranges::for_each(
+			directory_iterator,
+			[&](const std::filesystem::directory_entry& entry) noexcept -> void
+			{
+				file_descriptor descriptor{};
+
+				if (entry.is_regular_file(error_code))
+				{
+					descriptor.is_directory = false;
+				}
+				else if (entry.is_directory(error_code))
+				{
+					descriptor.is_directory = true;
+				}
+
+				if (error_code)
+				{
+					descriptor.name = "???";
+					descriptor.extension = ".?";
+
+					descriptor.display_name = error_code.message();
+
+					std::format_to(
+						std::back_inserter(tooltip),
+						"\t{}\n\t\t{}\n",
+						entry.path().string(),
+						error_code.message()
+					);
+				}
+				else
+				{
+					const auto& entry_path = entry.path();
+
+					descriptor.name = entry_path.filename();
+					descriptor.extension = entry_path.extension();
+
+					if (descriptor.is_directory)
+					{
+						descriptor.display_name = std::format("[DIR] {}", descriptor.name.string());
+					}
+					else
+					{
+						descriptor.display_name = descriptor.name.string();
+					}
+				}
+
+				file_descriptors.push_back(std::move(descriptor));
+			}
+		);
+	}
+
+	// the sort of the previous FileBrowser::update_file_descriptors
+	auto previous_sort(std::vector<file_descriptor>& file_descriptors) noexcept -> void
+	{
+		if (file_descriptors.size() > 2)
+		{
+			std::ranges::sort(
+				// drop parent folder path
+				file_descriptors | std::views::drop(1),
+				[](const file_descriptor& lhs, const file_descriptor& rhs) noexcept -> bool
+				{
+					if (lhs.is_directory != rhs.is_directory)
+					{
+						return lhs.is_directory;
+					}
+
+					const auto to_lower_name = [](std::string& name) noexcept -> void
+					{
+						const auto to_lower = [](const char c) noexcept -> char
+						{
+							return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+						};
+
+						std::ranges::transform(name, name.begin(), to_lower);
+					};
+
+					auto lhs_name = lhs.name.string();
+					auto rhs_name = rhs.name.string();
+
+					to_lower_name(lhs_name);
+					to_lower_name(rhs_name);
+
+					return lhs_name < rhs_name;
+				}
+			);
+		}
+	}
+}
+
+auto main(const int argc, char** argv) noexcept -> int
+{
+	const auto count = benchmark::entry_count(argc, argv, 100'000);
+	const auto directory = benchmark::make_directory(
+		"enumerate",
+		count,
+		[](const std::size_t index) noexcept -> std::string
+		{
+			return std::format("asset_{}.bin", index);
+		}
+	);
+
+	std::vector<double> previous_enumerate_runs{};
+	std::vector<double> previous_runs{};
+	for (int run = 0; run < benchmark::default_runs; ++run)
+	{
+		std::vector<file_descriptor> file_descriptors{};
+
+		const auto start = benchmark::clock_type::now();
+		previous_enumerate(directory, file_descriptors);
+		const auto enumerated = benchmark::clock_type::now();
+		previous_sort(file_descriptors);
+		const auto sorted = benchmark::clock_type::now();
+
+		previous_enumerate_runs.push_back(benchmark::to_milliseconds(enumerated - start));
+		previous_runs.push_back(benchmark::to_milliseconds(sorted - start));
+	}
+
+	// enumerated and sorted right away (without FileBrowserFlags::ASYNC_SCAN)
+	ImGui::FileBrowser file_browser{"benchmark", ImGui::FileBrowserFlags::NONE, directory};
+	file_browser.open();
+
+	std::vector<double> file_browser_enumerate_runs{};
+	std::vector<double> file_browser_runs{};
+	for (int run = 0; run < benchmark::default_runs; ++run)
+	{
+		file_browser.reset_statistics();
+
+		const auto start = benchmark::clock_type::now();
+		file_browser.set_working_directory(directory);
+		file_browser_runs.push_back(benchmark::to_milliseconds(benchmark::clock_type::now() - start));
+
+		// the enumeration only (the descriptors, the names and the sort keys are built while enumerating)
+		const auto& statistics = file_browser.get_statistics(ImGui::FileBrowser::StatisticsPhase::FILESYSTEM_LIST);
+		file_browser_enumerate_runs.push_back(benchmark::to_milliseconds(statistics.total));
+	}
+
+	std::printf("%zu entries, median of %d runs\n", count, benchmark::default_runs);
+	std::printf("  previous enumeration:                      %8.1f ms\n", benchmark::median(previous_enumerate_runs));
+	std::printf("  previous enumeration + sort:               %8.1f ms\n", benchmark::median(previous_runs));
+	std::printf("  FileBrowser enumeration (FILESYSTEM_LIST): %8.1f ms\n", benchmark::median(file_browser_enumerate_runs));
+	std::printf("  FileBrowser::set_working_directory:        %8.1f ms\n", benchmark::median(file_browser_runs));
+
+	return 0;
+}
@@ -0,0 +1,128 @@
+// the filters of the FileBrowser (FileBrowser::FilterMatcher), matches per second over generated names (in memory)
+// the compiled matcher against the previous matching (std::filesystem::path::extension compared with every filter string)
+// usage: IMFB_BENCHMARK_filter [entries = 1000000]
+
+#include <benchmark.hpp>
+
+#include <array>
+#include <random>
+#include <span>
+#include <string_view>
+
+namespace
+{
+	// the filter of is_filter_matched before the matcher, the plain extensions only
+	[[nodiscard]] auto previous_match(const std::span<const std::string_view> filters, const std::string& name) noexcept -> bool
+	{
+		const auto extension = std::filesystem::path{name}.extension().string();
+
+		return std::ranges::any_of(
+			filters,
+			[&extension](const std::string_view filter) noexcept -> bool
+			{
+				return filter == extension;
+			}
+		);
+	}
+
+	struct result_type
+	{
+		// millions of names per second
+		double rate;
+		std::size_t matched;
+	};
+
+	template<typename Match>
+	[[nodiscard]] auto measure(const std::vector<std::string>& names, Match match) noexcept -> result_type
+	{
+		std::vector<double> runs{};
+		std::size_t matched = 0;
+		for (int run = 0; run < benchmark::default_runs; ++run)
+		{
+			matched = 0;
+
+			const auto start = benchmark::clock_type::now();
+			for (const auto& name: names)
+			{
+				matched += match(name) ? 1 : 0;
+			}
+			runs.push_back(benchmark::to_milliseconds(benchmark::clock_type::now() - start));
+		}
+
+		return {.rate = static_cast<double>(names.size()) / benchmark::median(runs) / 1000, .matched = matched};
+	}
+
+	[[nodiscard]] auto make_matcher(const std::span<const std::string_view> filters) noexcept -> ImGui::FileBrowser::FilterMatcher
+	{
+		ImGui::FileBrowser::FilterMatcher matcher{};
+		for (const auto filter: filters)
+		{
+			matcher.add(filter);
+		}
+
+		return matcher;
+	}
+}
+
+auto main(const int argc, char** argv) noexcept -> int
+{
+	const auto count = benchmark::entry_count(argc, argv, 1'000'000);
+
+	// the names of an asset directory
+	constexpr std::array<std::string_view, 8> formats
+	{
+			"texture_{}_albedo.png",
+			"texture_{}_normal.png",
+			"scene_{}.json",
+			"backup_{}.tar.gz",
+			"mesh_{}.fbx",
+			"readme_{}.txt",
+			"frame_{}.exr",
+			"Makefile_{}",
+	};
+
+	std::mt19937_64 random{42};
+	std::vector<std::string> names{};
+	names.reserve(count);
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		names.push_back(std::vformat(formats[random() % formats.size()], std::make_format_args(i)));
+	}
+
+	constexpr std::array<std::string_view, 4> extension_filters{".png", ".json", ".fbx", ".txt"};
+	constexpr std::array<std::string_view, 3> glob_filters{"*_normal.png", "scene_*.json", ".tar.gz"};
+	constexpr std::array<std::string_view, 7> combined_filters{".png", ".json", ".fbx", ".txt", "*_normal.png", "scene_*.json", ".tar.gz"};
+
+	const auto previous = measure(
+		names,
+		[&](const std::string& name) noexcept -> bool
+		{
+			return previous_match(extension_filters, name);
+		}
+	);
+
+	const auto run_matcher = [&](const std::span<const std::string_view> filters) noexcept -> result_type
+	{
+		const auto matcher = make_matcher(filters);
+
+		return measure(
+			names,
+			[&matcher](const std::string& name) noexcept -> bool
+			{
+				return matcher.match(name);
+			}
+		);
+	};
+
+	const auto extensions = run_matcher(extension_filters);
+	const auto globs = run_matcher(glob_filters);
+	const auto combined = run_matcher(combined_filters);
+
+	std::printf("%zu names, median of %d runs\n", count, benchmark::default_runs);
+	std::printf("  previous extension compare:          %8.1f M/s (%zu matched)\n", previous.rate, previous.matched);
+	std::printf("  matcher, plain extensions:           %8.1f M/s (%zu matched)\n", extensions.rate, extensions.matched);
+	std::printf("  matcher, globs / multi-dot:          %8.1f M/s (%zu matched)\n", globs.rate, globs.matched);
+	std::printf("  matcher, combined:                   %8.1f M/s (%zu matched)\n", combined.rate, combined.matched);
+
+	return 0;
+}
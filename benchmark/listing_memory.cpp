@@ -0,0 +1,147 @@
+// the memory of a large listing (FileBrowserFlags::NONE)
+// the allocations / the heap per entry of the first load and of a reload (the buffers of the listing are reused), the load time and the time of a steady frame
+// usage: IMFB_BENCHMARK_listing_memory [entries = 100000]
+
+#include <benchmark.hpp>
+
+#include <atomic>
+#include <cstring>
+#include <new>
+
+namespace
+{
+	std::atomic<std::size_t> g_allocations{0};
+	std::atomic<std::size_t> g_live_bytes{0};
+
+	// the size of each block is stored in front of it, the alignment of operator new is kept
+	constexpr std::size_t header_size = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+	[[nodiscard]] auto allocate(const std::size_t size) -> void*
+	{
+		auto* block = static_cast<unsigned char*>(std::malloc(size + header_size));
+		if (block == nullptr)
+		{
+			throw std::bad_alloc{};
+		}
+
+		std::memcpy(block, &size, sizeof(size));
+
+		g_allocations.fetch_add(1, std::memory_order_relaxed);
+		g_live_bytes.fetch_add(size, std::memory_order_relaxed);
+
+		return block + header_size;
+	}
+
+	auto deallocate(void* pointer) noexcept -> void
+	{
+		if (pointer == nullptr)
+		{
+			return;
+		}
+
+		auto* block = static_cast<unsigned char*>(pointer) - header_size;
+
+		std::size_t size;
+		std::memcpy(&size, block, sizeof(size));
+
+		g_live_bytes.fetch_sub(size, std::memory_order_relaxed);
+
+		std::free(block);
+	}
+}
+
+auto operator new(const std::size_t size) -> void*
+{
+	return allocate(size);
+}
+
+auto operator new[](const std::size_t size) -> void*
+{
+	return allocate(size);
+}
+
+auto operator delete(void* pointer) noexcept -> void
+{
+	deallocate(pointer);
+}
+
+auto operator delete[](void* pointer) noexcept -> void
+{
+	deallocate(pointer);
+}
+
+auto operator delete(void* pointer, std::size_t) noexcept -> void
+{
+	deallocate(pointer);
+}
+
+auto operator delete[](void* pointer, std::size_t) noexcept -> void
+{
+	deallocate(pointer);
+}
+
+auto main(const int argc, char** argv) noexcept -> int
+{
+	const auto count = benchmark::entry_count(argc, argv, 100'000);
+	const auto directory = benchmark::make_directory(
+		"listing_memory",
+		count,
+		[](const std::size_t index) noexcept -> std::string
+		{
+			return std::format("texture_{}.png", index);
+		}
+	);
+
+	benchmark::HeadlessContext context{};
+
+	// the first load (the constructor does not enumerate, open does)
+	const auto allocations_before_load = g_allocations.load();
+	const auto live_bytes_before_load = g_live_bytes.load();
+
+	ImGui::FileBrowser file_browser{"benchmark", ImGui::FileBrowserFlags::NONE, directory};
+	file_browser.open();
+
+	const auto load_allocations = g_allocations.load() - allocations_before_load;
+	const auto load_live_bytes = g_live_bytes.load() - live_bytes_before_load;
+
+	context.frame(file_browser);
+
+	// the reloads of the same directory
+	std::vector<double> reload_runs{};
+	std::size_t reload_allocations = 0;
+	for (int run = 0; run < benchmark::default_runs; ++run)
+	{
+		const auto allocations_before_reload = g_allocations.load();
+
+		const auto start = benchmark::clock_type::now();
+		file_browser.set_working_directory(directory);
+		reload_runs.push_back(benchmark::to_milliseconds(benchmark::clock_type::now() - start));
+
+		reload_allocations = g_allocations.load() - allocations_before_reload;
+	}
+
+	// the steady frames (ImGui::NewFrame + show + ImGui::Render)
+	for (int frame = 0; frame < 10; ++frame)
+	{
+		context.frame(file_browser);
+	}
+
+	std::vector<double> frame_runs{};
+	for (int frame = 0; frame < 60; ++frame)
+	{
+		const auto start = benchmark::clock_type::now();
+		context.frame(file_browser);
+		frame_runs.push_back(benchmark::to_milliseconds(benchmark::clock_type::now() - start));
+	}
+
+	const auto entries = static_cast<double>(count);
+
+	std::printf("%zu entries\n", count);
+	std::printf("  allocations per entry (first load): %8.3f\n", static_cast<double>(load_allocations) / entries);
+	std::printf("  allocations per entry (reload):     %8.3f\n", static_cast<double>(reload_allocations) / entries);
+	std::printf("  heap bytes per entry:               %8.1f\n", static_cast<double>(load_live_bytes) / entries);
+	std::printf("  reload (median of %d runs):          %8.1f ms\n", benchmark::default_runs, benchmark::median(reload_runs));
+	std::printf("  frame (median of 60 frames):        %8.3f ms\n", benchmark::median(frame_runs));
+
+	return 0;
+}
@@ -0,0 +1,187 @@
+// the sort of "frame_<n>.exr" names (FileBrowserFlags::NONE / FileBrowserFlags::NATURAL_SORT)
+// the encoded sort keys of the FileBrowser (built and sorted by set_flags) against the previous comparator (a lowercase copy of both names on each compare) and a natural comparator parsing the digits on each compare
+// usage: IMFB_BENCHMARK_natural_sort [entries = 100000]
+
+#include <benchmark.hpp>
+
+#include <numeric>
+#include <random>
+
+namespace
+{
+	// the comparator of update_file_descriptors before the sort keys
+	[[nodiscard]] auto previous_less(const std::string& lhs, const std::string& rhs) noexcept -> bool
+	{
+		const auto to_lower_name = [](std::string& name) noexcept -> void
+		{
+			const auto to_lower = [](const char c) noexcept -> char
+			{
+				return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+			};
+
+			std::ranges::transform(name, name.begin(), to_lower);
+		};
+
+		auto lhs_name = lhs;
+		auto rhs_name = rhs;
+
+		to_lower_name(lhs_name);
+		to_lower_name(rhs_name);
+
+		return lhs_name < rhs_name;
+	}
+
+	// the digit runs are compared by value (leading zeros skipped, then the length, then the digits) on each compare
+	[[nodiscard]] auto natural_less(const std::string_view lhs, const std::string_view rhs) noexcept -> bool
+	{
+		const auto is_digit = [](const char c) noexcept -> bool
+		{
+			return c >= '0' and c <= '9';
+		};
+		const auto to_lower = [](const char c) noexcept -> char
+		{
+			return (c >= 'A' and c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+		};
+
+		std::size_t i = 0;
+		std::size_t j = 0;
+		while (i < lhs.size() and j < rhs.size())
+		{
+			if (is_digit(lhs[i]) and is_digit(rhs[j]))
+			{
+				while (i < lhs.size() and lhs[i] == '0')
+				{
+					i += 1;
+				}
+				while (j < rhs.size() and rhs[j] == '0')
+				{
+					j += 1;
+				}
+
+				auto lhs_end = i;
+				while (lhs_end < lhs.size() and is_digit(lhs[lhs_end]))
+				{
+					lhs_end += 1;
+				}
+				auto rhs_end = j;
+				while (rhs_end < rhs.size() and is_digit(rhs[rhs_end]))
+				{
+					rhs_end += 1;
+				}
+
+				if (lhs_end - i != rhs_end - j)
+				{
+					return lhs_end - i < rhs_end - j;
+				}
+				if (const auto result = lhs.substr(i, lhs_end - i).compare(rhs.substr(j, rhs_end - j));
+					result != 0)
+				{
+					return result < 0;
+				}
+
+				i = lhs_end;
+				j = rhs_end;
+				continue;
+			}
+
+			if (const auto l = to_lower(lhs[i]), r = to_lower(rhs[j]);
+				l != r)
+			{
+				return static_cast<unsigned char>(l) < static_cast<unsigned char>(r);
+			}
+
+			i += 1;
+			j += 1;
+		}
+
+		return lhs.size() - i < rhs.size() - j;
+	}
+
+	template<typename Less>
+	[[nodiscard]] auto measure_comparator(const std::vector<std::string>& names, Less less) noexcept -> double
+	{
+		std::vector<double> runs{};
+		for (int run = 0; run < benchmark::default_runs; ++run)
+		{
+			auto sorted = names;
+
+			const auto start = benchmark::clock_type::now();
+			std::ranges::sort(sorted, less);
+			runs.push_back(benchmark::to_milliseconds(benchmark::clock_type::now() - start));
+		}
+
+		return benchmark::median(runs);
+	}
+
+	// FileBrowser::set_flags rebuilds the sort keys of the listing and sorts it again when the sort order changes
+	[[nodiscard]] auto measure_file_browser(const std::filesystem::path& directory) noexcept -> std::pair<double, double>
+	{
+		ImGui::FileBrowser file_browser{"benchmark", ImGui::FileBrowserFlags::NONE, directory};
+		file_browser.open();
+
+		std::vector<double> lexical_runs{};
+		std::vector<double> natural_runs{};
+		for (int run = 0; run < benchmark::default_runs; ++run)
+		{
+			const auto start = benchmark::clock_type::now();
+			file_browser.set_flags(ImGui::FileBrowserFlags::NATURAL_SORT);
+			const auto natural = benchmark::clock_type::now();
+			file_browser.set_flags(ImGui::FileBrowserFlags::NONE);
+			const auto lexical = benchmark::clock_type::now();
+
+			natural_runs.push_back(benchmark::to_milliseconds(natural - start));
+			lexical_runs.push_back(benchmark::to_milliseconds(lexical - natural));
+		}
+
+		return {benchmark::median(lexical_runs), benchmark::median(natural_runs)};
+	}
+}
+
+auto main(const int argc, char** argv) noexcept -> int
+{
+	const auto count = benchmark::entry_count(argc, argv, 100'000);
+
+	// created in a shuffled order, the enumeration order of some file systems follows the creation order
+	std::vector<std::size_t> numbers(count);
+	std::iota(numbers.begin(), numbers.end(), std::size_t{0});
+	std::ranges::shuffle(numbers, std::mt19937_64{42});
+
+	const auto directory = benchmark::make_directory(
+		"natural_sort",
+		count,
+		[&numbers](const std::size_t index) noexcept -> std::string
+		{
+			return std::format("frame_{}.exr", numbers[index]);
+		}
+	);
+
+	// the comparators sort the names in the enumeration order too
+	std::vector<std::string> names{};
+	names.reserve(count);
+	for (const auto& entry: std::filesystem::directory_iterator{directory})
+	{
+		if (entry.is_regular_file())
+		{
+			names.push_back(entry.path().filename().string());
+		}
+	}
+
+	const auto previous = measure_comparator(names, previous_less);
+	const auto per_compare_natural = measure_comparator(
+		names,
+		[](const std::string& lhs, const std::string& rhs) noexcept -> bool
+		{
+			return natural_less(lhs, rhs);
+		}
+	);
+
+	const auto [lexical_keys, natural_keys] = measure_file_browser(directory);
+
+	std::printf("%zu entries, median of %d runs\n", count, benchmark::default_runs);
+	std::printf("  previous comparator:                 %8.1f ms\n", previous);
+	std::printf("  per-compare natural comparator:      %8.1f ms\n", per_compare_natural);
+	std::printf("  FileBrowser lexical keys + sort:     %8.1f ms\n", lexical_keys);
+	std::printf("  FileBrowser natural keys + sort:     %8.1f ms\n", natural_keys);
+
+	return 0;
+}
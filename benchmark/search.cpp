@@ -0,0 +1,85 @@
+// the search field (FileBrowserFlags::SEARCH_BOX), the time of each keystroke while a query is typed character by character
+// the first character scans the character masks of every name, the next ones only rescan the previous matches (StatisticsPhase::SEARCH)
+// usage: IMFB_BENCHMARK_search [entries = 500000]
+
+#include <benchmark.hpp>
+
+#include <array>
+#include <string_view>
+
+auto main(const int argc, char** argv) noexcept -> int
+{
+	const auto count = benchmark::entry_count(argc, argv, 500'000);
+
+	// the names of an asset directory
+	constexpr std::array<std::string_view, 8> formats
+	{
+			"texture_{}_albedo.png",
+			"texture_{}_normal.png",
+			"scene_{}.json",
+			"backup_{}.tar.gz",
+			"mesh_lod_{}.fbx",
+			"readme_{}.txt",
+			"frame_{}.exr",
+			"BrickWall_{}_roughness.tga",
+	};
+
+	const auto directory = benchmark::make_directory(
+		"search",
+		count,
+		[&formats](const std::size_t index) noexcept -> std::string
+		{
+			return std::vformat(formats[index % formats.size()], std::make_format_args(index));
+		}
+	);
+
+	// a broad query (matched by most names until the last characters), an abbreviation (word starts) and an exact name
+	constexpr std::array<std::string_view, 3> queries{"normal", "bw42r", "mesh_lod_123453"};
+
+	const benchmark::HeadlessContext context{};
+
+	ImGui::FileBrowser file_browser{"benchmark", ImGui::FileBrowserFlags::SEARCH_BOX, directory};
+	file_browser.open();
+	// the listing
+	context.frame(file_browser);
+
+	// the names are folded / masked once per listing, by the first keystroke
+	file_browser.set_search_query("a");
+	file_browser.reset_statistics();
+	context.frame(file_browser);
+	const auto index_time = benchmark::to_milliseconds(file_browser.get_statistics(ImGui::FileBrowser::StatisticsPhase::SEARCH).total);
+
+	std::printf("%zu entries, median of %d runs\n", count, benchmark::default_runs);
+	std::printf("  first query after listing (folded names + masks): %8.2f ms\n", index_time);
+
+	for (const auto query: queries)
+	{
+		// [keystroke][run]
+		std::vector<std::vector<double>> keystroke_runs(query.size());
+
+		for (int run = 0; run < benchmark::default_runs; ++run)
+		{
+			file_browser.set_search_query({});
+			context.frame(file_browser);
+
+			for (std::size_t size = 1; size <= query.size(); ++size)
+			{
+				file_browser.set_search_query(query.substr(0, size));
+
+				file_browser.reset_statistics();
+				context.frame(file_browser);
+
+				const auto& statistics = file_browser.get_statistics(ImGui::FileBrowser::StatisticsPhase::SEARCH);
+				keystroke_runs[size - 1].push_back(benchmark::to_milliseconds(statistics.total));
+			}
+		}
+
+		std::printf("  \"%.*s\"\n", static_cast<int>(query.size()), query.data());
+		for (std::size_t size = 1; size <= query.size(); ++size)
+		{
+			std::printf("    %-16.*s %8.2f ms\n", static_cast<int>(size), query.data(), benchmark::median(keystroke_runs[size - 1]));
+		}
+	}
+
+	return 0;
+}
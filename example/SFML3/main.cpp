@@ -4,6 +4,14 @@
 
 #include <SFML/Graphics.hpp>
 
+namespace
+{
+	// the workers of the file browser cannot wake up the event loop, check them this often while idle
+	const auto idle_timeout = sf::milliseconds(100);
+	// ImGui needs a few frames to settle after an input (popups, focus, layout)
+	constexpr int settle_frames = 3;
+}
+
 auto main() noexcept -> int
 {
 	sf::RenderWindow window{sf::VideoMode{{1920, 1080}}, "IMFB + SFML3"};
@@ -18,16 +26,49 @@ auto main() noexcept -> int
 		return 1;
 	}
 
-	while (window.isOpen())
+	// frames left to draw after the last event
+	int pending_frames = settle_frames;
+
+	const auto process_event = [&](const sf::Event& event) noexcept -> void
 	{
-		while (const auto event = window.pollEvent())
+		ImGui::SFML::ProcessEvent(window, event);
+
+		if (event.is<sf::Event::Closed>())
 		{
-			ImGui::SFML::ProcessEvent(window, *event);
+			window.close();
+		}
+
+		pending_frames = settle_frames;
+	};
 
-			if (event->is<sf::Event::Closed>())
+	while (window.isOpen())
+	{
+		// nothing to draw, sleep until an event arrives (or the file browser has something new to show)
+		if (pending_frames == 0 and not texture_atlas.needs_redraw())
+		{
+			if (const auto event = window.waitEvent(idle_timeout))
 			{
-				window.close();
+				process_event(*event);
 			}
+			else
+			{
+				continue;
+			}
+		}
+
+		while (const auto event = window.pollEvent())
+		{
+			process_event(*event);
+		}
+
+		if (not window.isOpen())
+		{
+			break;
+		}
+
+		if (pending_frames != 0)
+		{
+			pending_frames -= 1;
 		}
 
 		ImGui::SFML::Update(window, delta_clock.restart());
@@ -1,11 +1,58 @@
 #include <texture_atlas.hpp>
 
+#include <algorithm>
+#include <cstring>
 #include <print>
 
 #include <SFML/Graphics.hpp>
 
 #include <imgui.h>
 
+namespace
+{
+	// decoded by sf::Image on the workers of the file browser, nearest neighbour downscale
+	class ImageThumbnailProvider final : public ImGui::FileBrowser::ThumbnailProvider
+	{
+	public:
+		[[nodiscard]] auto decode(const std::filesystem::path& path, const std::uint32_t size, ImGui::FileBrowser::thumbnail_image_type& image) noexcept -> bool override
+		{
+			sf::Image source{};
+			if (not source.loadFromFile(path))
+			{
+				return false;
+			}
+
+			const auto [source_width, source_height] = source.getSize();
+			if (source_width == 0 or source_height == 0)
+			{
+				return false;
+			}
+
+			const auto scale = std::min(1.f, static_cast<float>(size) / static_cast<float>(std::max(source_width, source_height)));
+			image.width = std::max(1u, static_cast<std::uint32_t>(static_cast<float>(source_width) * scale));
+			image.height = std::max(1u, static_cast<std::uint32_t>(static_cast<float>(source_height) * scale));
+			image.pixels.resize(static_cast<std::size_t>(image.width) * image.height * 4);
+
+			const auto* source_pixels = source.getPixelsPtr();
+			for (std::uint32_t y = 0; y < image.height; ++y)
+			{
+				const auto source_y = static_cast<std::size_t>(y) * source_height / image.height;
+				for (std::uint32_t x = 0; x < image.width; ++x)
+				{
+					const auto source_x = static_cast<std::size_t>(x) * source_width / image.width;
+					std::memcpy(
+						image.pixels.data() + (static_cast<std::size_t>(y) * image.width + x) * 4,
+						source_pixels + (source_y * source_width + source_x) * 4,
+						4
+					);
+				}
+			}
+
+			return true;
+		}
+	};
+}
+
 TextureAtlas::TextureAtlas() noexcept
 	: file_browser_{"TextureAtlas"},
 	  current_atlas_{texture_atlas_.end()}
@@ -19,9 +66,35 @@ TextureAtlas::TextureAtlas() noexcept
 		ImGui::FileBrowserFlags::ALLOW_SET_WORKING_DIRECTORY,
 		ImGui::FileBrowserFlags::ALLOW_CREATE,
 		ImGui::FileBrowserFlags::ALLOW_RENAME,
-		ImGui::FileBrowserFlags::ALLOW_DELETE
+		ImGui::FileBrowserFlags::ALLOW_DELETE,
+		ImGui::FileBrowserFlags::GRID_VIEW
 	);
 	file_browser_.set_filter({".jpg", ".jpeg", ".png"});
+
+	file_browser_.set_thumbnail_provider(
+		std::make_shared<ImageThumbnailProvider>(),
+		[this](const ImGui::FileBrowser::thumbnail_image_type& image) noexcept -> ImGui::FileBrowser::thumbnail_texture_type
+		{
+			sf::Texture texture{};
+			if (not texture.resize({image.width, image.height}))
+			{
+				return 0;
+			}
+			texture.update(image.pixels.data());
+
+			// same as imgui-SFML, the ImTextureID holds the bytes of the OpenGL handle
+			ImGui::FileBrowser::thumbnail_texture_type texture_id{0};
+			const auto handle = texture.getNativeHandle();
+			std::memcpy(&texture_id, &handle, sizeof(handle));
+
+			thumbnails_.emplace(texture_id, std::move(texture));
+			return texture_id;
+		},
+		[this](const ImGui::FileBrowser::thumbnail_texture_type texture_id) noexcept -> void
+		{
+			thumbnails_.erase(texture_id);
+		}
+	);
 }
 
 auto TextureAtlas::show() noexcept -> void
@@ -78,6 +151,11 @@ auto TextureAtlas::show() noexcept -> void
 	ImGui::End();
 }
 
+auto TextureAtlas::needs_redraw() const noexcept -> bool
+{
+	return file_browser_.needs_redraw();
+}
+
 auto TextureAtlas::render(sf::RenderWindow& window) noexcept -> void
 {
 	if (current_atlas_ != texture_atlas_.end())
@@ -16,8 +16,12 @@ class TextureAtlas
 {
 public:
 	using texture_atlas_type = std::unordered_map<std::filesystem::path, sf::Texture>;
+	using thumbnails_type = std::unordered_map<ImGui::FileBrowser::thumbnail_texture_type, sf::Texture>;
 
 private:
+	// uploaded by the file browser, declared first so that the file browser releases them before they are destroyed
+	thumbnails_type thumbnails_;
+
 	ImGui::FileBrowser file_browser_;
 
 	texture_atlas_type texture_atlas_;
@@ -28,5 +32,8 @@ public:
 
 	auto show() noexcept -> void;
 
+	// the file browser has something new to show (the rest of the window only changes on input)
+	[[nodiscard]] auto needs_redraw() const noexcept -> bool;
+
 	auto render(sf::RenderWindow& window) noexcept -> void;
 };
@@ -6,14 +6,44 @@
 #include <imgui-file_browser.hpp>
 
 #include <algorithm>
+#include <array>
 #include <cassert>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
 #include <format>
 #include <fstream>
+#include <limits>
+#include <list>
+#include <mutex>
+#include <numeric>
 #include <optional>
 #include <ranges>
+#include <stop_token>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 
 #include <imgui.h>
 
+#if defined(IMFB_PLATFORM_LINUX)
+#include <dirent.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <linux/io_uring.h>
+#include <sys/inotify.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#elif defined(IMFB_PLATFORM_DARWIN)
+#include <sys/stat.h>
+#endif
+
 namespace
 {
 	using ImGui::FileBrowser;
@@ -41,6 +71,32 @@ namespace
 			: function_{function} {}
 	};
 
+#if IMFB_STATISTICS
+#define IMFB_STATISTICS_CONCAT_IMPL(lhs, rhs) lhs##rhs
+#define IMFB_STATISTICS_CONCAT(lhs, rhs) IMFB_STATISTICS_CONCAT_IMPL(lhs, rhs)
+
+	// time the rest of the enclosing scope (in a member function of FileBrowser)
+#define IMFB_STATISTICS_SCOPE(phase) \
+	const ScopeGuard IMFB_STATISTICS_CONCAT(statistics_guard_, __LINE__) \
+	{ \
+		[this, statistics_start = std::chrono::steady_clock::now()] \
+		{ \
+			record_statistics(phase, std::chrono::steady_clock::now() - statistics_start); \
+		} \
+	}
+
+	// time a single expression (usually a filesystem call), the value of the expression is returned
+#define IMFB_STATISTICS_CALL(phase, ...) \
+	[&]() noexcept -> decltype(auto) \
+	{ \
+		IMFB_STATISTICS_SCOPE(phase); \
+		return __VA_ARGS__; \
+	}()
+#else
+#define IMFB_STATISTICS_SCOPE(phase) static_cast<void>(0)
+#define IMFB_STATISTICS_CALL(phase, ...) (__VA_ARGS__)
+#endif
+
 	FileBrowser::size_type default_x{0};
 	FileBrowser::size_type default_y{0};
 	FileBrowser::size_type default_width{700};
@@ -75,9 +131,287 @@ namespace
 		return 0;
 	}
 
+	[[nodiscard]] auto format_file_size(const std::uintmax_t size) noexcept -> std::string
+	{
+		constexpr std::array<std::string_view, 5> units{"B", "KiB", "MiB", "GiB", "TiB"};
+
+		auto value = static_cast<double>(size);
+		std::size_t unit = 0;
+		while (value >= 1024 and unit + 1 < units.size())
+		{
+			value /= 1024;
+			unit += 1;
+		}
+
+		if (unit == 0)
+		{
+			return std::format("{} {}", size, units[unit]);
+		}
+		return std::format("{:.1f} {}", value, units[unit]);
+	}
+
+	[[nodiscard]] auto format_permissions(const std::filesystem::perms permissions) noexcept -> std::string
+	{
+		using std::filesystem::perms;
+
+		const auto test = [permissions](const perms p, const char c) noexcept -> char
+		{
+			return (permissions & p) != perms::none ? c : '-';
+		};
+
+		return {
+				test(perms::owner_read, 'r'),
+				test(perms::owner_write, 'w'),
+				test(perms::owner_exec, 'x'),
+				test(perms::group_read, 'r'),
+				test(perms::group_write, 'w'),
+				test(perms::group_exec, 'x'),
+				test(perms::others_read, 'r'),
+				test(perms::others_write, 'w'),
+				test(perms::others_exec, 'x'),
+		};
+	}
+
+	// "YYYY-MM-DD HH:MM:SS", null-terminated
+	[[nodiscard]] auto format_last_write_time(const std::chrono::system_clock::time_point last_write_time) noexcept -> std::array<char, 20>
+	{
+		std::array<char, 20> result{};
+
+		std::format_to_n(result.data(), result.size() - 1, "{:%Y-%m-%d %H:%M:%S}", std::chrono::floor<std::chrono::seconds>(last_write_time));
+
+		return result;
+	}
+
+	// stable LSD radix sort of values by keys (both end up sorted), 11 bits per pass, the passes where all keys have the same digit are skipped
+	// the buffers are the scratch space of the passes, they only grow (kept by the caller so that a sort per frame does not allocate)
+	auto radix_sort(
+		const std::span<std::uint64_t> keys,
+		const std::span<std::uint32_t> values,
+		std::vector<std::uint64_t>& keys_buffer,
+		std::vector<std::uint32_t>& values_buffer
+	) noexcept -> void
+	{
+		assert(keys.size() == values.size());
+
+		constexpr std::size_t digit_bits = 11;
+		constexpr std::size_t bucket_count = std::size_t{1} << digit_bits;
+		constexpr std::size_t max_pass_count = (std::numeric_limits<std::uint64_t>::digits + digit_bits - 1) / digit_bits;
+
+		const auto digit_of = [](const std::uint64_t key, const std::size_t pass) noexcept -> std::size_t
+		{
+			return static_cast<std::size_t>(key >> (pass * digit_bits)) & (bucket_count - 1);
+		};
+
+		// the digits above the highest bit set are not even counted
+		const auto key_bits = static_cast<std::size_t>(std::bit_width(std::accumulate(keys.begin(), keys.end(), std::uint64_t{0}, std::bit_or{})));
+		const auto pass_count = (key_bits + digit_bits - 1) / digit_bits;
+
+		std::array<std::array<std::size_t, bucket_count>, max_pass_count> histograms{};
+		for (const auto key: keys)
+		{
+			for (std::size_t pass = 0; pass < pass_count; ++pass)
+			{
+				histograms[pass][digit_of(key, pass)] += 1;
+			}
+		}
+
+		if (keys_buffer.size() < keys.size())
+		{
+			keys_buffer.resize(keys.size());
+			values_buffer.resize(values.size());
+		}
+
+		auto source_keys = keys;
+		auto source_values = values;
+		auto destination_keys = std::span{keys_buffer}.first(keys.size());
+		auto destination_values = std::span{values_buffer}.first(values.size());
+
+		for (std::size_t pass = 0; pass < pass_count; ++pass)
+		{
+			auto& histogram = histograms[pass];
+
+			if (std::ranges::contains(histogram, keys.size()))
+			{
+				continue;
+			}
+
+			// offsets
+			std::size_t offset = 0;
+			for (auto& count: histogram)
+			{
+				offset += std::exchange(count, offset);
+			}
+
+			for (std::size_t i = 0; i < source_keys.size(); ++i)
+			{
+				const auto position = histogram[digit_of(source_keys[i], pass)]++;
+
+				destination_keys[position] = source_keys[i];
+				destination_values[position] = source_values[i];
+			}
+
+			std::swap(source_keys, destination_keys);
+			std::swap(source_values, destination_values);
+		}
+
+		if (source_values.data() != values.data())
+		{
+			std::ranges::copy(source_keys, keys.begin());
+			std::ranges::copy(source_values, values.begin());
+		}
+	}
+
+	// ascii only, same as std::tolower in the "C" locale (the sort keys, the extension order and the search fold with it)
+	[[nodiscard]] constexpr auto to_lower(const char c) noexcept -> char
+	{
+		return (c >= 'A' and c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+	}
+
+	// SortOrder::NATURAL: the encoded length of a digit run in a sort key (see FileBrowser::file_listing::append_sort_key)
+	// one byte below 255, otherwise 255 followed by the 4 bytes of the length (big-endian), memcmp still orders the lengths
+	auto append_digit_run_length(std::string& key, const std::size_t length) noexcept -> void
+	{
+		constexpr auto long_length = std::numeric_limits<unsigned char>::max();
+
+		if (length < long_length)
+		{
+			key.push_back(static_cast<char>(static_cast<unsigned char>(length)));
+			return;
+		}
+
+		assert(length <= std::numeric_limits<std::uint32_t>::max());
+
+		key.push_back(static_cast<char>(long_length));
+		for (int shift = 24; shift >= 0; shift -= 8)
+		{
+			key.push_back(static_cast<char>(static_cast<unsigned char>(length >> shift)));
+		}
+	}
+
+	// the bit of a lowercase character in the character mask of a name (FileBrowserFlags::SEARCH_BOX)
+	// the letters and the digits have their own bit, the other characters share the remaining bits
+	constexpr auto search_character_bits = []() noexcept -> std::array<std::uint64_t, 256>
+	{
+		std::array<std::uint64_t, 256> bits{};
+
+		for (std::size_t c = 0; c < bits.size(); ++c)
+		{
+			if (c >= 'a' and c <= 'z')
+			{
+				bits[c] = std::uint64_t{1} << (c - 'a');
+			}
+			else if (c >= '0' and c <= '9')
+			{
+				bits[c] = std::uint64_t{1} << (26 + c - '0');
+			}
+			else
+			{
+				bits[c] = std::uint64_t{1} << (36 + c % 28);
+			}
+		}
+
+		return bits;
+	}();
+
+	[[nodiscard]] auto search_character_mask(const std::string_view folded) noexcept -> std::uint64_t
+	{
+		std::uint64_t mask = 0;
+		for (const auto c: folded)
+		{
+			mask |= search_character_bits[static_cast<unsigned char>(c)];
+		}
+
+		return mask;
+	}
+
+	// the fuzzy subsequence score of query (lowercase) in a name (folded is the lowercase name), 0 if the query is not a subsequence of the name
+	// the characters are located with std::string_view::find / rfind (memchr), the tightest window ending at the first complete match is scored:
+	// the consecutive characters and the characters starting a word score more, the gaps, a late start and the unmatched length less
+	[[nodiscard]] auto fuzzy_score(const std::string_view query, const std::string_view folded, const std::string_view name) noexcept -> std::uint32_t
+	{
+		assert(not query.empty());
+		assert(folded.size() == name.size());
+
+		// forward, the end of the first complete match
+		std::size_t last = 0;
+		for (std::size_t position = 0; const auto c: query)
+		{
+			last = folded.find(c, position);
+			if (last == std::string_view::npos)
+			{
+				return 0;
+			}
+
+			position = last + 1;
+		}
+
+		// backward, the latest start of a match ending at last
+		auto first = last + 1;
+		for (const auto c: query | std::views::reverse)
+		{
+			first = folded.rfind(c, first - 1);
+		}
+
+		const auto is_word_start = [name](const std::size_t i) noexcept -> bool
+		{
+			if (i == 0)
+			{
+				return true;
+			}
+
+			const auto previous = name[i - 1];
+			if (previous == '_' or previous == '-' or previous == '.' or previous == ' ')
+			{
+				return true;
+			}
+
+			// camelCase
+			return (name[i] >= 'A' and name[i] <= 'Z') and (previous >= 'a' and previous <= 'z');
+		};
+
+		constexpr std::int64_t base_score = 1 << 16;
+		constexpr std::int64_t match_score = 16;
+		constexpr std::int64_t consecutive_bonus = 16;
+		constexpr std::int64_t word_start_bonus = 12;
+
+		auto score = base_score;
+
+		auto i = first;
+		auto previous = std::string_view::npos;
+		for (const auto c: query)
+		{
+			while (folded[i] != c)
+			{
+				i += 1;
+			}
+
+			score += match_score;
+			if (previous != std::string_view::npos)
+			{
+				score += i == previous + 1 ? consecutive_bonus : -static_cast<std::int64_t>(std::ranges::min(i - previous - 1, std::size_t{8}));
+			}
+			if (is_word_start(i))
+			{
+				score += word_start_bonus;
+			}
+
+			previous = i;
+			i += 1;
+		}
+
+		score -= static_cast<std::int64_t>(std::ranges::min(first, std::size_t{16}));
+		score -= static_cast<std::int64_t>(std::ranges::min(name.size() - query.size(), std::size_t{64}) / 4);
+
+		return static_cast<std::uint32_t>(std::ranges::max(score, std::int64_t{1}));
+	}
+
 	template<typename T>
 		requires std::is_same_v<T, std::string> or std::is_same_v<T, std::string_view>
-	constexpr auto do_set_filters(std::vector<std::string>& old_filters, const std::span<const T> new_filters) noexcept -> void
+	constexpr auto do_set_filters(
+		std::vector<std::string>& old_filters,
+		std::vector<FileBrowser::FilterMatcher>& old_matchers,
+		const std::span<const T> new_filters
+	) noexcept -> void
 	{
 		old_filters.clear();
 		old_filters.reserve(new_filters.size() + 1);
@@ -145,444 +479,4476 @@ namespace
 		{
 			std::unreachable();
 		}
+
+		// compiled once, the combined filter ([0], if any) matches the union of the filters
+		const auto combined = old_filters.size() != new_filters.size();
+
+		old_matchers.clear();
+		old_matchers.resize(old_filters.size());
+
+		for (const auto [index, filter]: std::views::enumerate(new_filters))
+		{
+			if (combined)
+			{
+				old_matchers.front().add(filter);
+			}
+
+			old_matchers[static_cast<std::size_t>(index) + combined].add(filter);
+		}
 	}
 }
 
 // ReSharper disable once CppInconsistentNaming
 namespace ImGui
 {
-	auto FileBrowser::has_state(const StateCategory state) const noexcept -> bool
+	auto FileBrowser::transparent_string_hash::operator()(const std::string_view string) const noexcept -> std::size_t
 	{
-#if IMFB_DEBUG
-		switch (state)
+		return std::hash<std::string_view>{}(string);
+	}
+
+	auto FileBrowser::FilterMatcher::segment(const segment_type& segment) const noexcept -> std::string_view
+	{
+		return {bytes_.data() + segment.offset, segment.size};
+	}
+
+	auto FileBrowser::FilterMatcher::match_glob(const glob_type& glob, std::string_view name) const noexcept -> bool
+	{
+		if (name.size() < glob.min_size)
 		{
-			case StateCategory::NONE:
-			{
-				std::unreachable();
-			}
-			case StateCategory::POSITION_DIRTY:
-			{
-				return states_.position_dirty;
-			}
-			case StateCategory::OPENING:
-			{
-				return states_.window_opening;
-			}
-			case StateCategory::CLOSING:
-			{
-				return states_.window_closing;
-			}
-			case StateCategory::OPENED:
-			{
-				return states_.window_opened;
-			}
-			case StateCategory::SELECTED:
-			{
-				return states_.selected;
-			}
-			case StateCategory::FOCUSING_EDITOR_NEXT_FRAME:
-			{
-				return states_.focusing_editor_next_frame;
-			}
-			case StateCategory::SET_WORKING_DIRECTORY_NEXT_FRAME:
-			{
-				return states_.set_working_directory_next_frame;
-			}
-			case StateCategory::DELETE_SELECTED_NEXT_FRAME:
-			{
-				return states_.delete_selected_next_frame;
-			}
-			case StateCategory::SETTING_WORKING_DIRECTORY:
-			{
-				return states_.setting_working_directory;
-			}
-			case StateCategory::CREATING_FILE:
-			{
-				return states_.creating_file;
-			}
-			case StateCategory::CREATING_DIRECTORY:
-			{
-				return states_.creating_directory;
-			}
-			case StateCategory::CREATING:
+			return false;
+		}
+
+		// '?' matches any byte
+		const auto equal = [](const std::string_view pattern, const std::string_view bytes) noexcept -> bool
+		{
+			return std::ranges::equal(
+				pattern,
+				bytes,
+				[](const char p, const char b) noexcept -> bool
+				{
+					return p == '?' or p == b;
+				}
+			);
+		};
+
+		auto segments = std::span{segments_}.subspan(glob.first_segment, glob.segment_count);
+
+		if (glob.exact)
+		{
+			return name.size() == glob.min_size and (segments.empty() or equal(segment(segments.front()), name));
+		}
+
+		// the anchored segments first, they are the most selective ("*.png", "scene_*")
+		if (glob.anchored_front and not segments.empty())
+		{
+			const auto front = segment(segments.front());
+			if (not equal(front, name.substr(0, front.size())))
 			{
-				return states_.creating_file or states_.creating_directory;
+				return false;
 			}
-			case StateCategory::RENAMING_FILE:
+
+			name.remove_prefix(front.size());
+			segments = segments.subspan(1);
+		}
+
+		if (glob.anchored_back and not segments.empty())
+		{
+			const auto back = segment(segments.back());
+			if (not equal(back, name.substr(name.size() - back.size())))
 			{
-				return states_.renaming_file;
+				return false;
 			}
-			case StateCategory::RENAMING_DIRECTORY:
+
+			name.remove_suffix(back.size());
+			segments = segments.subspan(0, segments.size() - 1);
+		}
+
+		// each '*' in between takes the shortest run, the leftmost match of the next segment leaves the most room to the following ones
+		for (const auto& each: segments)
+		{
+			const auto pattern = segment(each);
+
+			auto position = std::string_view::npos;
+			if (not each.has_any)
 			{
-				return states_.renaming_directory;
+				position = name.find(pattern);
 			}
-			case StateCategory::RENAMING:
+			else
 			{
-				return states_.renaming_file or states_.renaming_directory;
+				for (std::size_t i = 0; i + pattern.size() <= name.size(); ++i)
+				{
+					if (equal(pattern, name.substr(i, pattern.size())))
+					{
+						position = i;
+						break;
+					}
+				}
 			}
-			default:
+
+			if (position == std::string_view::npos)
 			{
-				std::unreachable();
+				return false;
 			}
+
+			name.remove_prefix(position + pattern.size());
 		}
-#else
-		assert(state != StateCategory::NONE);
 
-		return std::to_underlying(states_) & std::to_underlying(state);
-#endif
+		return true;
 	}
 
-	auto FileBrowser::append_state(const StateCategory state) noexcept -> void
+	FileBrowser::FilterMatcher::FilterMatcher() noexcept
+		: everything_{false} {}
+
+	auto FileBrowser::FilterMatcher::add(const std::string_view filter) noexcept -> void
 	{
-#if IMFB_DEBUG
-		switch (state)
+		if (filter == wildcard_filter or filter == "*")
 		{
-			case StateCategory::NONE:
-			{
-				std::unreachable();
-			}
-			case StateCategory::POSITION_DIRTY:
-			{
-				states_.position_dirty = 1;
-				break;
-			}
+			everything_ = true;
+			return;
+		}
+
+		const auto is_wildcard = [](const char c) noexcept -> bool
+		{
+			return c == '*' or c == '?';
+		};
+
+		// "*.png" ==> ".png"
+		if (filter.starts_with("*.") and filter.find_first_of("*?.", 2) == std::string_view::npos)
+		{
+			extensions_.emplace(filter.substr(1));
+			return;
+		}
+
+		// ".png" (or "", no extension)
+		if (filter.empty() or (filter.front() == '.' and filter.find('.', 1) == std::string_view::npos and not std::ranges::any_of(filter, is_wildcard)))
+		{
+			extensions_.emplace(filter);
+			return;
+		}
+
+		// ".tar.gz" ==> "*.tar.gz", "Makefile" stays exact
+		const auto suffix = filter.front() == '.' and not std::ranges::any_of(filter, is_wildcard);
+
+		assert(bytes_.size() + filter.size() <= std::numeric_limits<std::uint32_t>::max());
+
+		glob_type glob
+		{
+				.first_segment = static_cast<std::uint32_t>(segments_.size()),
+				.segment_count = 0,
+				.min_size = 0,
+				.anchored_front = not suffix and filter.front() != '*',
+				.anchored_back = filter.back() != '*',
+				.exact = not suffix and not filter.contains('*')
+		};
+
+		for (const auto part: filter | std::views::split('*'))
+		{
+			const std::string_view bytes{part.begin(), part.end()};
+			if (bytes.empty())
+			{
+				continue;
+			}
+
+			segments_.push_back({.offset = static_cast<std::uint32_t>(bytes_.size()), .size = static_cast<std::uint32_t>(bytes.size()), .has_any = bytes.contains('?')});
+			bytes_.append(bytes);
+
+			glob.segment_count += 1;
+			glob.min_size += static_cast<std::uint32_t>(bytes.size());
+		}
+
+		globs_.push_back(glob);
+	}
+
+	auto FileBrowser::FilterMatcher::clear() noexcept -> void
+	{
+		extensions_.clear();
+		bytes_.clear();
+		segments_.clear();
+		globs_.clear();
+		everything_ = false;
+	}
+
+	auto FileBrowser::FilterMatcher::matches_everything() const noexcept -> bool
+	{
+		return everything_;
+	}
+
+	auto FileBrowser::FilterMatcher::has_globs() const noexcept -> bool
+	{
+		return not globs_.empty();
+	}
+
+	auto FileBrowser::FilterMatcher::match_extension(const std::string_view extension) const noexcept -> bool
+	{
+		return everything_ or extensions_.contains(extension);
+	}
+
+	auto FileBrowser::FilterMatcher::match_globs(const std::string_view name) const noexcept -> bool
+	{
+		return std::ranges::any_of(
+			globs_,
+			[this, name](const glob_type& glob) noexcept -> bool
+			{
+				return match_glob(glob, name);
+			}
+		);
+	}
+
+	auto FileBrowser::FilterMatcher::match(const std::string_view name) const noexcept -> bool
+	{
+		return match_extension(extension_of(name)) or match_globs(name);
+	}
+
+	auto FileBrowser::FilterMatcher::extension_of(const std::string_view name) noexcept -> std::string_view
+	{
+		if (const auto dot = name.rfind('.');
+			dot != std::string_view::npos and dot != 0 and name != "..")
+		{
+			return name.substr(dot);
+		}
+
+		return {};
+	}
+
+	auto FileBrowser::file_listing::size() const noexcept -> std::size_t
+	{
+		return descriptors.size();
+	}
+
+	auto FileBrowser::file_listing::empty() const noexcept -> bool
+	{
+		return descriptors.empty();
+	}
+
+	auto FileBrowser::file_listing::clear() noexcept -> void
+	{
+		descriptors.clear();
+		metadata.clear();
+		names.clear();
+		sort_keys.clear();
+		selection.clear();
+		selection_size = 0;
+		extensions.clear();
+		extension_ids.clear();
+	}
+
+	auto FileBrowser::file_listing::push_parent() noexcept -> void
+	{
+		push_back("..", true, SortOrder::LEXICAL);
+		descriptors.back().metadata_state = MetadataState::UNAVAILABLE;
+	}
+
+	auto FileBrowser::file_listing::push_back(const std::string_view name, const bool is_directory, const SortOrder sort_order) noexcept -> void
+	{
+		assert(name.size() <= std::numeric_limits<std::uint16_t>::max());
+
+		if (is_directory)
+		{
+			names.append(directory_prefix);
+		}
+
+		const auto name_offset = names.size();
+		names.append(name);
+		names.push_back('\0');
+
+		const auto sort_key_offset = sort_keys.size();
+		append_sort_key(sort_keys, name, sort_order);
+
+		assert(names.size() <= std::numeric_limits<std::uint32_t>::max());
+		assert(sort_keys.size() <= std::numeric_limits<std::uint32_t>::max());
+
+		const auto extension = FilterMatcher::extension_of(name);
+
+		descriptors.push_back(
+			{
+					.name_offset = static_cast<std::uint32_t>(name_offset),
+					.sort_key_offset = static_cast<std::uint32_t>(sort_key_offset),
+					.extension = intern_extension(extension),
+					.name_size = static_cast<std::uint16_t>(name.size()),
+					.sort_key_size = static_cast<std::uint16_t>(sort_keys.size() - sort_key_offset),
+					.is_directory = is_directory,
+					.metadata_state = MetadataState::NONE
+			}
+		);
+		metadata.emplace_back();
+
+		if (descriptors.size() > selection.size() * 64)
+		{
+			selection.push_back(0);
+		}
+	}
+
+	auto FileBrowser::file_listing::push_error(const std::error_code& error_code) noexcept -> void
+	{
+		// the message is displayed in place of the name
+		push_back(error_code.message(), false, SortOrder::LEXICAL);
+
+		auto& descriptor = descriptors.back();
+		descriptor.extension = intern_extension({});
+		descriptor.metadata_state = MetadataState::UNAVAILABLE;
+	}
+
+	auto FileBrowser::file_listing::append(const file_listing& other, const std::size_t first) noexcept -> void
+	{
+		const auto name_base = static_cast<std::uint32_t>(names.size());
+		const auto sort_key_base = static_cast<std::uint32_t>(sort_keys.size());
+
+		names.append(other.names);
+		sort_keys.append(other.sort_keys);
+
+		// other.extensions[i] => extensions[extension_map[i]]
+		std::vector<std::uint32_t> extension_map{};
+		extension_map.reserve(other.extensions.size());
+		for (const auto& extension: other.extensions)
+		{
+			extension_map.push_back(intern_extension(extension));
+		}
+
+		const auto offset = static_cast<std::ptrdiff_t>(first);
+
+		std::ranges::transform(
+			other.descriptors.begin() + offset,
+			other.descriptors.end(),
+			std::back_inserter(descriptors),
+			[name_base, sort_key_base, &extension_map](file_descriptor descriptor) noexcept -> file_descriptor
+			{
+				descriptor.name_offset += name_base;
+				descriptor.sort_key_offset += sort_key_base;
+				descriptor.extension = extension_map[descriptor.extension];
+				return descriptor;
+			}
+		);
+		metadata.insert(metadata.end(), other.metadata.begin() + offset, other.metadata.end());
+
+		selection.resize((descriptors.size() + 63) / 64, 0);
+	}
+
+	auto FileBrowser::file_listing::erase(const std::size_t index) noexcept -> void
+	{
+		// shift the selection of the following entries down, the bits past the last entry stay clear
+		for (auto i = index; i + 1 < size(); ++i)
+		{
+			if (is_selected(i + 1))
+			{
+				select(i);
+			}
+			else
+			{
+				deselect(i);
+			}
+		}
+		deselect(size() - 1);
+
+		const auto offset = static_cast<std::ptrdiff_t>(index);
+
+		descriptors.erase(descriptors.begin() + offset);
+		metadata.erase(metadata.begin() + offset);
+	}
+
+	auto FileBrowser::file_listing::permute(const std::span<const std::uint32_t> order) noexcept -> void
+	{
+		assert(order.size() == size());
+
+		const auto gather = [order]<typename T>(std::vector<T>& values) noexcept -> void
+		{
+			std::vector<T> result{};
+			result.reserve(values.size());
+
+			for (const auto index: order)
+			{
+				result.push_back(values[index]);
+			}
+
+			values.swap(result);
+		};
+
+		gather(descriptors);
+		gather(metadata);
+
+		if (selection_size != 0)
+		{
+			std::vector<std::uint64_t> result(selection.size(), 0);
+
+			for (std::size_t i = 0; i < order.size(); ++i)
+			{
+				if (is_selected(order[i]))
+				{
+					result[i / 64] |= std::uint64_t{1} << (i % 64);
+				}
+			}
+
+			selection.swap(result);
+		}
+	}
+
+	auto FileBrowser::file_listing::rebuild_sort_keys(const SortOrder sort_order) noexcept -> void
+	{
+		std::string keys{};
+		keys.reserve(sort_keys.size());
+
+		for (std::size_t index = 0; index < size(); ++index)
+		{
+			auto& descriptor = descriptors[index];
+
+			const auto sort_key_offset = keys.size();
+			append_sort_key(keys, name(index), sort_order);
+
+			descriptor.sort_key_offset = static_cast<std::uint32_t>(sort_key_offset);
+			descriptor.sort_key_size = static_cast<std::uint16_t>(keys.size() - sort_key_offset);
+		}
+
+		sort_keys.swap(keys);
+	}
+
+	auto FileBrowser::file_listing::intern_extension(const std::string_view extension) noexcept -> std::uint32_t
+	{
+		if (extensions.empty())
+		{
+			// no extension
+			extensions.emplace_back();
+			extension_ids.emplace(std::string{}, 0);
+		}
+
+		if (const auto it = extension_ids.find(extension);
+			it != extension_ids.end())
+		{
+			return it->second;
+		}
+
+		assert(extensions.size() < std::numeric_limits<std::uint32_t>::max());
+
+		const auto id = static_cast<std::uint32_t>(extensions.size());
+		extensions.emplace_back(extension);
+		extension_ids.emplace(extension, id);
+
+		return id;
+	}
+
+	auto FileBrowser::file_listing::is_selected(const std::size_t index) const noexcept -> bool
+	{
+		return (selection[index / 64] >> (index % 64)) & 1;
+	}
+
+	auto FileBrowser::file_listing::select(const std::size_t index) noexcept -> void
+	{
+		auto& word = selection[index / 64];
+		const auto bit = std::uint64_t{1} << (index % 64);
+
+		selection_size += (word & bit) == 0;
+		word |= bit;
+	}
+
+	auto FileBrowser::file_listing::deselect(const std::size_t index) noexcept -> void
+	{
+		auto& word = selection[index / 64];
+		const auto bit = std::uint64_t{1} << (index % 64);
+
+		selection_size -= (word & bit) != 0;
+		word &= ~bit;
+	}
+
+	auto FileBrowser::file_listing::select_none() noexcept -> void
+	{
+		if (selection_size != 0)
+		{
+			std::ranges::fill(selection, 0);
+			selection_size = 0;
+		}
+	}
+
+	auto FileBrowser::file_listing::selected_count() const noexcept -> std::size_t
+	{
+		return selection_size;
+	}
+
+	auto FileBrowser::file_listing::first_selected() const noexcept -> std::size_t
+	{
+		for (std::size_t i = 0; i < selection.size(); ++i)
+		{
+			if (selection[i] != 0)
+			{
+				return i * 64 + static_cast<std::size_t>(std::countr_zero(selection[i]));
+			}
+		}
+
+		return size();
+	}
+
+	auto FileBrowser::file_listing::name(const std::size_t index) const noexcept -> std::string_view
+	{
+		const auto& descriptor = descriptors[index];
+
+		return {names.data() + descriptor.name_offset, descriptor.name_size};
+	}
+
+	auto FileBrowser::file_listing::display_name(const std::size_t index) const noexcept -> const char*
+	{
+		const auto& descriptor = descriptors[index];
+
+		if (descriptor.is_directory)
+		{
+			if (name(index) == "..")
+			{
+				return parent_path_name.data();
+			}
+
+			return names.data() + descriptor.name_offset - directory_prefix.size();
+		}
+
+		return names.data() + descriptor.name_offset;
+	}
+
+	auto FileBrowser::file_listing::extension(const std::size_t index) const noexcept -> std::string_view
+	{
+		const auto& descriptor = descriptors[index];
+
+		return extensions[descriptor.extension];
+	}
+
+	auto FileBrowser::file_listing::sort_key(const std::size_t index) const noexcept -> std::pair<bool, std::string_view>
+	{
+		const auto& descriptor = descriptors[index];
+
+		return {not descriptor.is_directory, {sort_keys.data() + descriptor.sort_key_offset, descriptor.sort_key_size}};
+	}
+
+	auto FileBrowser::file_listing::bytes() const noexcept -> std::size_t
+	{
+		return
+				sizeof(file_listing) +
+				descriptors.capacity() * sizeof(file_descriptor) +
+				metadata.capacity() * sizeof(file_metadata) +
+				names.capacity() +
+				sort_keys.capacity() +
+				selection.capacity() * sizeof(std::uint64_t) +
+				extensions.capacity() * sizeof(std::string) +
+				// the nodes of extension_ids (roughly)
+				extension_ids.size() * (sizeof(std::string) + sizeof(std::uint32_t) + 2 * sizeof(void*));
+	}
+
+	// folded with to_lower (ascii only)
+	// SortOrder::NATURAL: each digit run is encoded as '0' + length (without the leading zeros, see append_digit_run_length) + digits,
+	// so that the keys still compare with memcmp, a longer number is greater and the digits keep their position relative to the other characters
+	auto FileBrowser::file_listing::append_sort_key(std::string& key, const std::string_view name, const SortOrder sort_order) noexcept -> void
+	{
+		const auto is_digit = [](const char c) noexcept -> bool
+		{
+			return c >= '0' and c <= '9';
+		};
+
+		if (sort_order == SortOrder::LEXICAL)
+		{
+			std::ranges::transform(name, std::back_inserter(key), to_lower);
+			return;
+		}
+
+		for (std::size_t i = 0; i < name.size();)
+		{
+			if (not is_digit(name[i]))
+			{
+				key.push_back(to_lower(name[i]));
+				i += 1;
+				continue;
+			}
+
+			auto last = i;
+			while (last < name.size() and is_digit(name[last]))
+			{
+				last += 1;
+			}
+
+			auto first = i;
+			while (first < last and name[first] == '0')
+			{
+				first += 1;
+			}
+
+			key.push_back('0');
+			append_digit_run_length(key, last - first);
+			key.append(name.substr(first, last - first));
+
+			i = last;
+		}
+	}
+
+	auto FileBrowser::breadcrumb::label(const std::size_t index) const noexcept -> const char*
+	{
+		return labels.data() + segments[index].label_offset;
+	}
+
+	auto FileBrowser::breadcrumb::prefix(const std::size_t index) const noexcept -> std::string_view
+	{
+		return std::string_view{path}.substr(0, segments[index].prefix_size);
+	}
+
+	class FileBrowser::DirectoryScanner final : public std::enable_shared_from_this<DirectoryScanner>
+	{
+	public:
+		// the first batch is published as soon as possible (a slow network filesystem still shows entries quickly),
+		// then the batch grows to keep the number of merges (ui thread) small
+		constexpr static std::size_t initial_batch_size = 256;
+		constexpr static std::size_t max_batch_size = 32768;
+
+		constexpr static auto unlimited = std::numeric_limits<std::size_t>::max();
+
+		enum class ScanState : std::uint8_t
+		{
+			RUNNING,
+			// the limit is reached, waiting for load_more
+			LIMITED,
+			FINISHED,
+		};
+
+	private:
+		// resumable enumeration, the directory is opened by the first next
+		class Enumerator final
+		{
+		public:
+			Enumerator(const Enumerator&) noexcept = delete;
+			Enumerator(Enumerator&&) noexcept = delete;
+			auto operator=(const Enumerator&) noexcept -> Enumerator& = delete;
+			auto operator=(Enumerator&&) noexcept -> Enumerator& = delete;
+
+		private:
+			std::filesystem::path directory_;
+			SortOrder sort_order_;
+
+#if defined(IMFB_PLATFORM_LINUX)
+			int directory_fd_;
+
+			// getdents64 records, [buffer_offset_, buffer_size_) are not consumed yet
+			std::unique_ptr<char[]> buffer_;
+			long buffer_offset_;
+			long buffer_size_;
+#else
+			std::filesystem::directory_iterator directory_iterator_;
+#endif
+
+			bool opened_;
+			bool finished_;
+
+			[[nodiscard]] auto open(std::string& tooltip) noexcept -> bool
+			{
+				opened_ = true;
+
+#if defined(IMFB_PLATFORM_LINUX)
+				directory_fd_ = ::open(directory_.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+				if (directory_fd_ == -1)
+				{
+					set_iterate_error(tooltip, directory_, std::error_code{errno, std::system_category()});
+					return false;
+				}
+
+				buffer_ = std::make_unique_for_overwrite<char[]>(buffer_capacity);
+#else
+				std::error_code error_code{};
+				directory_iterator_ = std::filesystem::directory_iterator{directory_, error_code};
+
+				if (error_code)
+				{
+					set_iterate_error(tooltip, directory_, error_code);
+					return false;
+				}
+#endif
+
+				return true;
+			}
+
+		public:
+#if defined(IMFB_PLATFORM_LINUX)
+			constexpr static std::size_t buffer_capacity = 64 * 1024;
+#endif
+
+			Enumerator(std::filesystem::path directory, const SortOrder sort_order) noexcept
+				: directory_{std::move(directory)},
+				  sort_order_{sort_order},
+#if defined(IMFB_PLATFORM_LINUX)
+				  directory_fd_{-1},
+				  buffer_offset_{0},
+				  buffer_size_{0},
+#endif
+				  opened_{false},
+				  finished_{false} {}
+
+			~Enumerator() noexcept
+			{
+#if defined(IMFB_PLATFORM_LINUX)
+				if (directory_fd_ != -1)
+				{
+					::close(directory_fd_);
+				}
+#endif
+			}
+
+			[[nodiscard]] auto is_finished() const noexcept -> bool
+			{
+				return finished_;
+			}
+
+			// append at most count entries to listing, errors are appended to tooltip, stop as soon as a stop is requested
+			// return the number of entries enumerated
+			auto next(
+				const std::stop_token& stop_token,
+				std::string& tooltip,
+				const std::size_t count,
+				file_listing& listing
+			) noexcept -> std::size_t
+			{
+				if (finished_)
+				{
+					return 0;
+				}
+
+				if (not opened_ and not open(tooltip))
+				{
+					finished_ = true;
+					return 0;
+				}
+
+				std::size_t enumerated = 0;
+
+#if defined(IMFB_PLATFORM_LINUX)
+				// read the getdents64 records directly, the file type comes from d_type,
+				// only DT_UNKNOWN (filesystem does not fill d_type) and DT_LNK (follow the link like std::filesystem::status) need a fstatat
+				while (enumerated < count)
+				{
+					if (buffer_offset_ == buffer_size_)
+					{
+						const auto read = ::syscall(SYS_getdents64, directory_fd_, buffer_.get(), buffer_capacity);
+
+						if (read == -1)
+						{
+							append_error(tooltip, directory_, std::error_code{errno, std::system_category()});
+						}
+
+						if (read <= 0)
+						{
+							finished_ = true;
+							break;
+						}
+
+						buffer_offset_ = 0;
+						buffer_size_ = read;
+					}
+
+					if (stop_token.stop_requested())
+					{
+						break;
+					}
+
+					const auto* entry = reinterpret_cast<const ::dirent64*>(buffer_.get() + buffer_offset_);
+					buffer_offset_ += entry->d_reclen;
+
+					const std::string_view name{entry->d_name};
+
+					if (name == "." or name == "..")
+					{
+						continue;
+					}
+
+					std::error_code error_code{};
+					bool is_directory = false;
+
+					switch (entry->d_type)
+					{
+						case DT_DIR:
+						{
+							is_directory = true;
+							break;
+						}
+						case DT_UNKNOWN:
+						case DT_LNK:
+						{
+							if (struct stat status{};
+								::fstatat(directory_fd_, entry->d_name, &status, 0) == 0)
+							{
+								is_directory = S_ISDIR(status.st_mode);
+							}
+							// dangling link, not an error (same as std::filesystem::status)
+							else if (errno != ENOENT)
+							{
+								error_code = std::error_code{errno, std::system_category()};
+							}
+							break;
+						}
+						default:
+						{
+							break;
+						}
+					}
+
+					if (error_code)
+					{
+						append_error(tooltip, directory_ / name, error_code);
+						listing.push_error(error_code);
+					}
+					else
+					{
+						listing.push_back(name, is_directory, sort_order_);
+					}
+
+					enumerated += 1;
+				}
+#else
+				std::error_code error_code{};
+
+				for (; enumerated < count; directory_iterator_.increment(error_code))
+				{
+					if (error_code)
+					{
+						append_error(tooltip, directory_, error_code);
+						finished_ = true;
+						break;
+					}
+
+					if (directory_iterator_ == std::filesystem::directory_iterator{})
+					{
+						finished_ = true;
+						break;
+					}
+
+					if (stop_token.stop_requested())
+					{
+						break;
+					}
+
+					const auto& entry = *directory_iterator_;
+
+					bool is_directory = false;
+
+					if (entry.is_regular_file(error_code))
+					{
+						is_directory = false;
+					}
+					else if (entry.is_directory(error_code))
+					{
+						is_directory = true;
+					}
+
+					if (error_code)
+					{
+						append_error(tooltip, entry.path(), error_code);
+						listing.push_error(error_code);
+					}
+					else
+					{
+						listing.push_back(entry.path().filename().string(), is_directory, sort_order_);
+					}
+
+					enumerated += 1;
+				}
+#endif
+
+				return enumerated;
+			}
+		};
+
+		// listings of at least this many entries are sorted by several threads
+		constexpr static std::size_t parallel_sort_threshold = 65536;
+		constexpr static std::size_t max_sort_workers = 8;
+
+		struct sort_entry
+		{
+			// directory bit (inverted, directories first) + the first 7 bytes of the sort key (big endian, zero padded)
+			std::uint64_t prefix;
+			std::uint32_t index;
+		};
+
+		[[nodiscard]] static auto make_sort_prefix(const file_listing& listing, const std::size_t index) noexcept -> std::uint64_t
+		{
+			const auto [group, sort_key] = listing.sort_key(index);
+
+			std::uint64_t prefix = group ? 1 : 0;
+
+			const auto length = std::ranges::min(sort_key.size(), sizeof(std::uint64_t) - 1);
+			for (std::size_t i = 0; i < sizeof(std::uint64_t) - 1; ++i)
+			{
+				prefix <<= 8;
+				if (i < length)
+				{
+					prefix |= static_cast<unsigned char>(sort_key[i]);
+				}
+			}
+
+			return prefix;
+		}
+
+		// sort the chunks concurrently, then merge them pairwise (each level concurrently too)
+		template<typename Less>
+		static auto parallel_sort(std::vector<sort_entry>& entries, const Less& less) noexcept -> void
+		{
+			const auto workers = std::ranges::clamp(
+				static_cast<std::size_t>(std::thread::hardware_concurrency()),
+				std::size_t{1},
+				max_sort_workers
+			);
+			const auto chunk_size = (entries.size() + workers - 1) / workers;
+
+			const auto bound = [&](const std::size_t offset) noexcept -> std::vector<sort_entry>::iterator
+			{
+				return entries.begin() + static_cast<std::ptrdiff_t>(std::ranges::min(offset, entries.size()));
+			};
+
+			std::vector<std::thread> threads{};
+			threads.reserve(workers);
+
+			for (std::size_t begin = 0; begin < entries.size(); begin += chunk_size)
+			{
+				threads.emplace_back(
+					[&less, first = bound(begin), last = bound(begin + chunk_size)]() noexcept -> void
+					{
+						std::sort(first, last, less);
+					}
+				);
+			}
+			std::ranges::for_each(threads, &std::thread::join);
+
+			for (auto width = chunk_size; width < entries.size(); width *= 2)
+			{
+				threads.clear();
+
+				for (std::size_t begin = 0; begin + width < entries.size(); begin += width * 2)
+				{
+					threads.emplace_back(
+						[&less, first = bound(begin), middle = bound(begin + width), last = bound(begin + width * 2)]() noexcept -> void
+						{
+							std::inplace_merge(first, middle, last, less);
+						}
+					);
+				}
+				std::ranges::for_each(threads, &std::thread::join);
+			}
+		}
+
+		Enumerator enumerator_;
+
+		std::stop_source stop_source_;
+
+		std::mutex mutex_;
+		std::condition_variable_any condition_variable_;
+		// each batch is sorted
+		std::vector<file_listing> batches_;
+		std::string tooltip_;
+		// the worker pauses once it enumerated this many entries,
+		// written under mutex_ (condition_variable_), read without it between chunks
+		std::atomic<std::size_t> limit_;
+		ScanState state_;
+
+		auto run() noexcept -> void
+		{
+			const auto stop_token = stop_source_.get_token();
+
+			auto batch_size = initial_batch_size;
+			file_listing batch{};
+
+			const auto publish = [&]() noexcept -> void
+			{
+				if (batch.empty())
+				{
+					return;
+				}
+
+				sort(batch, 0);
+
+				{
+					std::scoped_lock lock{mutex_};
+					batches_.push_back(std::move(batch));
+				}
+
+				batch_size = std::ranges::min(batch_size * 2, max_batch_size);
+				batch = {};
+			};
+
+			std::string tooltip{};
+			std::size_t enumerated = 0;
+
+			while (not enumerator_.is_finished())
+			{
+				const auto limit = limit_.load(std::memory_order_relaxed);
+
+				if (enumerated >= limit)
+				{
+					publish();
+
+					std::unique_lock lock{mutex_};
+					state_ = ScanState::LIMITED;
+
+					if (not condition_variable_.wait(
+						lock,
+						stop_token,
+						[&]() noexcept -> bool
+						{
+							return limit_.load(std::memory_order_relaxed) > enumerated;
+						}
+					))
+					{
+						// stop requested
+						return;
+					}
+
+					state_ = ScanState::RUNNING;
+					continue;
+				}
+
+				// enumerate up to the end of the batch (never past the limit), the limit is only checked between chunks
+				const auto chunk_size = std::ranges::min(batch_size - batch.size(), limit - enumerated);
+				const auto enumerated_now = enumerator_.next(stop_token, tooltip, chunk_size, batch);
+				enumerated += enumerated_now;
+
+				if (stop_token.stop_requested())
+				{
+					return;
+				}
+
+				if (batch.size() >= batch_size)
+				{
+					publish();
+				}
+			}
+
+			publish();
+
+			std::scoped_lock lock{mutex_};
+			tooltip_ = std::move(tooltip);
+			state_ = ScanState::FINISHED;
+		}
+
+	public:
+		DirectoryScanner(std::filesystem::path directory, const SortOrder sort_order, const std::size_t limit) noexcept
+			: enumerator_{std::move(directory), sort_order},
+			  limit_{limit},
+			  state_{ScanState::RUNNING} {}
+
+		// directories first, then case-insensitive name
+		[[nodiscard]] static auto less(const file_listing& listing, const std::size_t lhs, const std::size_t rhs) noexcept -> bool
+		{
+			return listing.sort_key(lhs) < listing.sort_key(rhs);
+		}
+
+		// sort the entries [first, size) of listing
+		static auto sort(file_listing& listing, const std::size_t first) noexcept -> void
+		{
+			if (listing.size() <= first + 1)
+			{
+				return;
+			}
+
+			assert(listing.size() <= std::numeric_limits<std::uint32_t>::max());
+
+			// sort a compact array of (prefix, index) instead of the descriptors themselves,
+			// most comparisons are decided by the prefix without touching the keys,
+			// then each descriptor is moved exactly once
+			std::vector<sort_entry> entries{};
+			entries.reserve(listing.size() - first);
+
+			for (auto index = static_cast<std::uint32_t>(first); index < listing.size(); ++index)
+			{
+				entries.push_back({.prefix = make_sort_prefix(listing, index), .index = index});
+			}
+
+			const auto entry_less = [&listing](const sort_entry& lhs, const sort_entry& rhs) noexcept -> bool
+			{
+				if (lhs.prefix != rhs.prefix)
+				{
+					return lhs.prefix < rhs.prefix;
+				}
+
+				return listing.sort_key(lhs.index).second < listing.sort_key(rhs.index).second;
+			};
+
+			if (entries.size() >= parallel_sort_threshold)
+			{
+				parallel_sort(entries, entry_less);
+			}
+			else
+			{
+				std::ranges::sort(entries, entry_less);
+			}
+
+			std::vector<std::uint32_t> order(listing.size());
+			std::iota(order.begin(), order.begin() + static_cast<std::ptrdiff_t>(first), std::uint32_t{0});
+			std::ranges::transform(entries, order.begin() + static_cast<std::ptrdiff_t>(first), &sort_entry::index);
+
+			listing.permute(order);
+		}
+
+		static auto append_error(std::string& tooltip, const std::filesystem::path& path, const std::error_code& error_code) noexcept -> void
+		{
+			if (tooltip.empty())
+			{
+				tooltip = "Error occurred\n";
+			}
+
+			std::format_to(
+				std::back_inserter(tooltip),
+				"\t{}\n\t\t{}\n",
+				path.string(),
+				error_code.message()
+			);
+		}
+
+		static auto set_iterate_error(std::string& tooltip, const std::filesystem::path& directory, const std::error_code& error_code) noexcept -> void
+		{
+			tooltip = std::format(
+				"Error occurred while iterate\n\t{}\n\t{}",
+				directory.string(),
+				error_code.message()
+			);
+		}
+
+		// append the whole directory to listing, errors are appended to tooltip, the enumeration stops as soon as a stop is requested
+		static auto enumerate(
+			const std::filesystem::path& directory,
+			const SortOrder sort_order,
+			const std::stop_token& stop_token,
+			std::string& tooltip,
+			file_listing& listing
+		) noexcept -> void
+		{
+			Enumerator enumerator{directory, sort_order};
+			enumerator.next(stop_token, tooltip, unlimited, listing);
+		}
+
+		// append the next count entries to listing on the calling thread (without worker), return true if the enumeration is completed
+		[[nodiscard]] auto step(std::string& tooltip, const std::size_t count, file_listing& listing) noexcept -> bool
+		{
+			enumerator_.next({}, tooltip, count, listing);
+
+			return enumerator_.is_finished();
+		}
+
+		auto start() noexcept -> void
+		{
+			// the worker holds the scanner until the enumeration is completed or cancelled, so the FileBrowser never waits (join) for it
+			std::thread{
+					[self = shared_from_this()]() noexcept -> void
+					{
+						self->run();
+					}
+			}.detach();
+		}
+
+		auto cancel() noexcept -> void
+		{
+			stop_source_.request_stop();
+		}
+
+		// let the worker enumerate count more entries
+		auto load_more(const std::size_t count) noexcept -> void
+		{
+			{
+				std::scoped_lock lock{mutex_};
+				const auto limit = limit_.load(std::memory_order_relaxed);
+				limit_.store(count > unlimited - limit ? unlimited : limit + count, std::memory_order_relaxed);
+				// do not report LIMITED again before the worker wakes up
+				state_ = ScanState::RUNNING;
+			}
+
+			condition_variable_.notify_all();
+		}
+
+		// new batches, or a state other than the last polled one (see FileBrowser::needs_redraw)
+		[[nodiscard]] auto has_results(const ScanState polled_state) noexcept -> bool
+		{
+			std::scoped_lock lock{mutex_};
+
+			return not batches_.empty() or state_ != polled_state;
+		}
+
+		// take the batches published since the last poll
+		[[nodiscard]] auto poll(std::vector<file_listing>& batches, std::string& tooltip) noexcept -> ScanState
+		{
+			std::scoped_lock lock{mutex_};
+
+			batches.swap(batches_);
+
+			if (state_ == ScanState::FINISHED)
+			{
+				tooltip = std::move(tooltip_);
+			}
+
+			return state_;
+		}
+	};
+
+	class FileBrowser::MetadataFetcher final : public std::enable_shared_from_this<MetadataFetcher>
+	{
+	public:
+		struct request_type
+		{
+			std::uint32_t generation;
+			// the index when requested, the entry may move before the result is polled (see FileBrowser::poll_file_metadata)
+			std::size_t index;
+			bool is_directory;
+			std::string name;
+			std::filesystem::path path;
+		};
+
+		struct result_type
+		{
+			std::uint32_t generation;
+			std::size_t index;
+			bool is_directory;
+			std::string name;
+			MetadataState state;
+			file_metadata metadata;
+		};
+
+		// number of statx submitted to io_uring at once (or taken by a fallback worker at once)
+		constexpr static std::size_t batch_size = 64;
+		// number of fallback workers if io_uring is unavailable
+		constexpr static std::size_t max_fallback_workers = 4;
+
+	private:
+#if defined(IMFB_PLATFORM_LINUX)
+		// minimal io_uring (no liburing), only used for IORING_OP_STATX
+		class IoUring final
+		{
+		public:
+			IoUring(const IoUring&) noexcept = delete;
+			IoUring(IoUring&&) noexcept = delete;
+			auto operator=(const IoUring&) noexcept -> IoUring& = delete;
+			auto operator=(IoUring&&) noexcept -> IoUring& = delete;
+
+		private:
+			int fd_;
+
+			void* submission_ring_;
+			std::size_t submission_ring_size_;
+			void* completion_ring_;
+			std::size_t completion_ring_size_;
+			::io_uring_sqe* submission_entries_;
+			std::size_t submission_entries_size_;
+
+			unsigned* submission_head_;
+			unsigned* submission_tail_;
+			unsigned* submission_mask_;
+			unsigned* submission_array_;
+
+			unsigned* completion_head_;
+			unsigned* completion_tail_;
+			unsigned* completion_mask_;
+			::io_uring_cqe* completion_entries_;
+
+		public:
+			IoUring() noexcept
+				: fd_{-1},
+				  submission_ring_{MAP_FAILED},
+				  submission_ring_size_{0},
+				  completion_ring_{MAP_FAILED},
+				  completion_ring_size_{0},
+				  submission_entries_{nullptr},
+				  submission_entries_size_{0},
+				  submission_head_{nullptr},
+				  submission_tail_{nullptr},
+				  submission_mask_{nullptr},
+				  submission_array_{nullptr},
+				  completion_head_{nullptr},
+				  completion_tail_{nullptr},
+				  completion_mask_{nullptr},
+				  completion_entries_{nullptr} {}
+
+			~IoUring() noexcept
+			{
+				if (submission_entries_ != nullptr)
+				{
+					::munmap(submission_entries_, submission_entries_size_);
+				}
+				if (completion_ring_ != MAP_FAILED and completion_ring_ != submission_ring_)
+				{
+					::munmap(completion_ring_, completion_ring_size_);
+				}
+				if (submission_ring_ != MAP_FAILED)
+				{
+					::munmap(submission_ring_, submission_ring_size_);
+				}
+				if (fd_ != -1)
+				{
+					::close(fd_);
+				}
+			}
+
+			[[nodiscard]] auto initialize(const unsigned entries) noexcept -> bool
+			{
+				::io_uring_params params{};
+
+				fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+				if (fd_ < 0)
+				{
+					fd_ = -1;
+					return false;
+				}
+
+				submission_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+				completion_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(::io_uring_cqe);
+				if (params.features & IORING_FEAT_SINGLE_MMAP)
+				{
+					submission_ring_size_ = std::ranges::max(submission_ring_size_, completion_ring_size_);
+					completion_ring_size_ = submission_ring_size_;
+				}
+
+				submission_ring_ = ::mmap(nullptr, submission_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQ_RING);
+				if (submission_ring_ == MAP_FAILED)
+				{
+					return false;
+				}
+
+				if (params.features & IORING_FEAT_SINGLE_MMAP)
+				{
+					completion_ring_ = submission_ring_;
+				}
+				else
+				{
+					completion_ring_ = ::mmap(nullptr, completion_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_CQ_RING);
+					if (completion_ring_ == MAP_FAILED)
+					{
+						return false;
+					}
+				}
+
+				submission_entries_size_ = params.sq_entries * sizeof(::io_uring_sqe);
+				auto* submission_entries = ::mmap(nullptr, submission_entries_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQES);
+				if (submission_entries == MAP_FAILED)
+				{
+					return false;
+				}
+				submission_entries_ = static_cast<::io_uring_sqe*>(submission_entries);
+
+				auto* submission_ring = static_cast<char*>(submission_ring_);
+				submission_head_ = reinterpret_cast<unsigned*>(submission_ring + params.sq_off.head);
+				submission_tail_ = reinterpret_cast<unsigned*>(submission_ring + params.sq_off.tail);
+				submission_mask_ = reinterpret_cast<unsigned*>(submission_ring + params.sq_off.ring_mask);
+				submission_array_ = reinterpret_cast<unsigned*>(submission_ring + params.sq_off.array);
+
+				auto* completion_ring = static_cast<char*>(completion_ring_);
+				completion_head_ = reinterpret_cast<unsigned*>(completion_ring + params.cq_off.head);
+				completion_tail_ = reinterpret_cast<unsigned*>(completion_ring + params.cq_off.tail);
+				completion_mask_ = reinterpret_cast<unsigned*>(completion_ring + params.cq_off.ring_mask);
+				completion_entries_ = reinterpret_cast<::io_uring_cqe*>(completion_ring + params.cq_off.cqes);
+
+				return true;
+			}
+
+			// submit all statx at once and wait for all of them, result[i] is the (negative errno) result of paths[i]
+			// paths must fit in the submission ring (initialize(entries) with entries >= paths.size())
+			[[nodiscard]] auto statx(const std::span<const char* const> paths, const std::span<struct statx> buffers, const std::span<int> results) noexcept -> bool
+			{
+				assert(paths.size() == buffers.size() and paths.size() == results.size());
+				assert(paths.size() <= *submission_mask_ + 1);
+
+				const auto mask = *submission_mask_;
+				auto tail = std::atomic_ref{*submission_tail_}.load(std::memory_order_relaxed);
+
+				for (std::size_t i = 0; i < paths.size(); ++i)
+				{
+					const auto index = tail & mask;
+					auto& entry = submission_entries_[index];
+
+					std::memset(&entry, 0, sizeof(entry));
+					entry.opcode = IORING_OP_STATX;
+					entry.fd = AT_FDCWD;
+					entry.addr = reinterpret_cast<std::uintptr_t>(paths[i]);
+					entry.len = STATX_TYPE | STATX_MODE | STATX_SIZE | STATX_MTIME;
+					entry.off = reinterpret_cast<std::uintptr_t>(&buffers[i]);
+					entry.statx_flags = AT_STATX_SYNC_AS_STAT;
+					entry.user_data = i;
+
+					submission_array_[index] = index;
+					tail += 1;
+				}
+
+				std::atomic_ref{*submission_tail_}.store(tail, std::memory_order_release);
+
+				const auto count = static_cast<unsigned>(paths.size());
+				// the kernel may consume only part of the entries (and then returns without waiting), the rest is submitted by the next calls
+				unsigned submitted = 0;
+				for (unsigned completed = 0; completed < count;)
+				{
+					if (const auto entered = ::syscall(__NR_io_uring_enter, fd_, count - submitted, count - completed, IORING_ENTER_GETEVENTS, nullptr, 0);
+						entered >= 0)
+					{
+						submitted += static_cast<unsigned>(entered);
+					}
+					else if (errno != EINTR)
+					{
+						return false;
+					}
+
+					auto head = std::atomic_ref{*completion_head_}.load(std::memory_order_relaxed);
+					const auto completion_tail = std::atomic_ref{*completion_tail_}.load(std::memory_order_acquire);
+
+					for (; head != completion_tail; ++head, ++completed)
+					{
+						const auto& entry = completion_entries_[head & *completion_mask_];
+						results[static_cast<std::size_t>(entry.user_data)] = entry.res;
+					}
+
+					std::atomic_ref{*completion_head_}.store(head, std::memory_order_release);
+				}
+
+				return true;
+			}
+		};
+
+		[[nodiscard]] static auto make_result(const struct statx& buffer) noexcept -> file_metadata
+		{
+			return
+			{
+					.size = buffer.stx_size,
+					.last_write_time = std::chrono::system_clock::time_point{
+							std::chrono::duration_cast<std::chrono::system_clock::duration>(
+								std::chrono::seconds{buffer.stx_mtime.tv_sec} + std::chrono::nanoseconds{buffer.stx_mtime.tv_nsec}
+							)
+					},
+					.permissions = static_cast<std::filesystem::perms>(buffer.stx_mode & 07777),
+			};
+		}
+#endif
+
+		std::mutex mutex_;
+		std::condition_variable condition_variable_;
+
+		// requests of an outdated generation are dropped without being fetched
+		std::atomic<std::uint32_t> generation_;
+		bool stopped_;
+
+		// the visible entries are always fetched first
+		std::deque<request_type> urgent_requests_;
+		std::deque<request_type> background_requests_;
+
+		std::vector<result_type> results_;
+
+		// wait for requests, return false if stopped
+		[[nodiscard]] auto take(std::vector<request_type>& requests) noexcept -> bool
+		{
+			std::unique_lock lock{mutex_};
+
+			condition_variable_.wait(
+				lock,
+				[this]() noexcept -> bool
+				{
+					return stopped_ or not urgent_requests_.empty() or not background_requests_.empty();
+				}
+			);
+
+			if (stopped_)
+			{
+				return false;
+			}
+
+			const auto current_generation = generation_.load(std::memory_order_relaxed);
+			for (auto* queue: {&urgent_requests_, &background_requests_})
+			{
+				while (not queue->empty() and requests.size() < batch_size)
+				{
+					if (queue->front().generation == current_generation)
+					{
+						requests.push_back(std::move(queue->front()));
+					}
+					queue->pop_front();
+				}
+			}
+
+			return true;
+		}
+
+		auto publish(std::vector<result_type>& results) noexcept -> void
+		{
+			std::scoped_lock lock{mutex_};
+
+			std::ranges::move(results, std::back_inserter(results_));
+			results.clear();
+		}
+
+		// statx without io_uring (or std::filesystem on other platforms)
+		[[nodiscard]] static auto fetch(request_type& request) noexcept -> result_type
+		{
+			result_type result{
+					.generation = request.generation,
+					.index = request.index,
+					.is_directory = request.is_directory,
+					.name = std::move(request.name),
+					.state = MetadataState::UNAVAILABLE,
+					.metadata = {}
+			};
+
+#if defined(IMFB_PLATFORM_LINUX)
+			if (struct statx buffer{};
+				::statx(AT_FDCWD, request.path.c_str(), AT_STATX_SYNC_AS_STAT, STATX_TYPE | STATX_MODE | STATX_SIZE | STATX_MTIME, &buffer) == 0)
+			{
+				result.state = MetadataState::READY;
+				result.metadata = make_result(buffer);
+			}
+#else
+			std::error_code error_code{};
+
+			const auto status = std::filesystem::status(request.path, error_code);
+			if (error_code)
+			{
+				return result;
+			}
+
+			const auto last_write_time = std::filesystem::last_write_time(request.path, error_code);
+			if (error_code)
+			{
+				return result;
+			}
+
+			result.metadata.size = is_regular_file(status) ? std::filesystem::file_size(request.path, error_code) : 0;
+			if (error_code)
+			{
+				return result;
+			}
+
+			result.state = MetadataState::READY;
+			// std::chrono::clock_cast is not available everywhere yet
+			result.metadata.last_write_time = std::chrono::time_point_cast<std::chrono::system_clock::duration>(
+				last_write_time - std::filesystem::file_time_type::clock::now() + std::chrono::system_clock::now()
+			);
+			result.metadata.permissions = status.permissions();
+#endif
+
+			return result;
+		}
+
+		auto run_fallback() noexcept -> void
+		{
+			std::vector<request_type> requests{};
+			std::vector<result_type> results{};
+
+			while (take(requests))
+			{
+				std::ranges::transform(requests, std::back_inserter(results), fetch);
+				requests.clear();
+
+				publish(results);
+			}
+		}
+
+		auto run() noexcept -> void
+		{
+#if defined(IMFB_PLATFORM_LINUX)
+			// IORING_OP_STATX requires linux 5.6, io_uring itself may also be disabled (kernel.io_uring_disabled / seccomp)
+			if (IoUring ring{};
+				ring.initialize(static_cast<unsigned>(batch_size)))
+			{
+				std::array<const char*, 1> probe_path{"/"};
+				std::array<struct statx, 1> probe_buffer{};
+				std::array<int, 1> probe_result{};
+
+				if (ring.statx(probe_path, probe_buffer, probe_result) and probe_result[0] >= 0)
+				{
+					std::vector<request_type> requests{};
+					std::vector<result_type> results{};
+
+					std::vector<const char*> paths{};
+					std::vector<struct statx> buffers{};
+					std::vector<int> codes{};
+
+					while (take(requests))
+					{
+						paths.clear();
+						std::ranges::transform(
+							requests,
+							std::back_inserter(paths),
+							[](const request_type& request) noexcept -> const char*
+							{
+								return request.path.c_str();
+							}
+						);
+						buffers.resize(requests.size());
+						codes.resize(requests.size());
+
+						if (not ring.statx(paths, buffers, codes))
+						{
+							// the ring is broken, let the fallback workers handle the rest
+							std::ranges::transform(requests, std::back_inserter(results), fetch);
+							requests.clear();
+							publish(results);
+							break;
+						}
+
+						for (std::size_t i = 0; i < requests.size(); ++i)
+						{
+							auto& request = requests[i];
+							auto& result = results.emplace_back(
+								request.generation,
+								request.index,
+								request.is_directory,
+								std::move(request.name),
+								MetadataState::UNAVAILABLE,
+								file_metadata{}
+							);
+
+							if (codes[i] >= 0)
+							{
+								result.state = MetadataState::READY;
+								result.metadata = make_result(buffers[i]);
+							}
+						}
+						requests.clear();
+
+						publish(results);
+					}
+
+					{
+						std::scoped_lock lock{mutex_};
+						if (stopped_)
+						{
+							return;
+						}
+					}
+				}
+			}
+#endif
+
+			// fallback: a few threads calling statx (std::filesystem) concurrently
+			const auto workers = std::ranges::clamp(static_cast<std::size_t>(std::thread::hardware_concurrency()), std::size_t{1}, max_fallback_workers);
+			for (std::size_t i = 1; i < workers; ++i)
+			{
+				std::thread{
+						[self = shared_from_this()]() noexcept -> void
+						{
+							self->run_fallback();
+						}
+				}.detach();
+			}
+
+			run_fallback();
+		}
+
+	public:
+		MetadataFetcher() noexcept
+			: generation_{0},
+			  stopped_{false} {}
+
+		auto start() noexcept -> void
+		{
+			// same as DirectoryScanner, the workers hold the fetcher until it is stopped
+			std::thread{
+					[self = shared_from_this()]() noexcept -> void
+					{
+						self->run();
+					}
+			}.detach();
+		}
+
+		auto stop() noexcept -> void
+		{
+			{
+				std::scoped_lock lock{mutex_};
+				stopped_ = true;
+			}
+
+			condition_variable_.notify_all();
+		}
+
+		// drop all queued requests (and the results which are not polled yet)
+		auto set_generation(const std::uint32_t generation) noexcept -> void
+		{
+			std::scoped_lock lock{mutex_};
+
+			generation_.store(generation, std::memory_order_relaxed);
+
+			urgent_requests_.clear();
+			background_requests_.clear();
+			results_.clear();
+		}
+
+		auto submit(std::vector<request_type>& requests, const bool urgent) noexcept -> void
+		{
+			if (requests.empty())
+			{
+				return;
+			}
+
+			{
+				std::scoped_lock lock{mutex_};
+
+				auto& queue = urgent ? urgent_requests_ : background_requests_;
+				std::ranges::move(requests, std::back_inserter(queue));
+			}
+			requests.clear();
+
+			condition_variable_.notify_all();
+		}
+
+		[[nodiscard]] auto has_results() noexcept -> bool
+		{
+			std::scoped_lock lock{mutex_};
+
+			return not results_.empty();
+		}
+
+		auto poll(std::vector<result_type>& results) noexcept -> void
+		{
+			std::scoped_lock lock{mutex_};
+
+			results.swap(results_);
+		}
+	};
+
+	class FileBrowser::DirectoryWatcher final
+	{
+	public:
+		DirectoryWatcher(const DirectoryWatcher&) noexcept = delete;
+		DirectoryWatcher(DirectoryWatcher&&) noexcept = delete;
+		auto operator=(const DirectoryWatcher&) noexcept -> DirectoryWatcher& = delete;
+		auto operator=(DirectoryWatcher&&) noexcept -> DirectoryWatcher& = delete;
+
+		enum class EventCategory : std::uint8_t
+		{
+			CREATED,
+			REMOVED,
+			// events lost or the directory itself is gone, rescan is required
+			RESCAN,
+		};
+
+		struct event_type
+		{
+			EventCategory category;
+			bool is_directory;
+			std::string name;
+		};
+
+	private:
+#if defined(IMFB_PLATFORM_LINUX)
+		int fd_;
+#endif
+
+	public:
+		explicit DirectoryWatcher(const std::filesystem::path& directory) noexcept
+#if defined(IMFB_PLATFORM_LINUX)
+			: fd_{::inotify_init1(IN_NONBLOCK | IN_CLOEXEC)}
+		{
+			if (fd_ == -1)
+			{
+				return;
+			}
+
+			if (::inotify_add_watch(
+				    fd_,
+				    directory.c_str(),
+				    IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR
+			    ) == -1)
+			{
+				::close(fd_);
+				fd_ = -1;
+			}
+		}
+#else
+		{
+			std::ignore = directory;
+		}
+#endif
+
+		~DirectoryWatcher() noexcept
+		{
+#if defined(IMFB_PLATFORM_LINUX)
+			if (fd_ != -1)
+			{
+				::close(fd_);
+			}
+#endif
+		}
+
+		[[nodiscard]] auto is_valid() const noexcept -> bool
+		{
+#if defined(IMFB_PLATFORM_LINUX)
+			return fd_ != -1;
+#else
+			return false;
+#endif
+		}
+
+		// the events are left in the queue for poll, never blocks
+		[[nodiscard]] auto has_events() const noexcept -> bool
+		{
+#if defined(IMFB_PLATFORM_LINUX)
+			::pollfd descriptor{.fd = fd_, .events = POLLIN, .revents = 0};
+
+			return fd_ != -1 and ::poll(&descriptor, 1, 0) > 0;
+#else
+			return false;
+#endif
+		}
+
+		// never blocks
+		auto poll(std::vector<event_type>& events) const noexcept -> void
+		{
+#if defined(IMFB_PLATFORM_LINUX)
+			alignas(::inotify_event) std::array<char, 16 * 1024> buffer;
+
+			while (true)
+			{
+				const auto read = ::read(fd_, buffer.data(), buffer.size());
+				if (read <= 0)
+				{
+					// EAGAIN: no more event
+					break;
+				}
+
+				for (ssize_t offset = 0; offset < read;)
+				{
+					const auto* event = reinterpret_cast<const ::inotify_event*>(buffer.data() + offset);
+					offset += static_cast<ssize_t>(sizeof(::inotify_event) + event->len);
+
+					const auto is_directory = (event->mask & IN_ISDIR) != 0;
+
+					if (event->mask & (IN_Q_OVERFLOW | IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED))
+					{
+						events.emplace_back(EventCategory::RESCAN, false, std::string{});
+					}
+					else if (event->mask & (IN_CREATE | IN_MOVED_TO))
+					{
+						events.emplace_back(EventCategory::CREATED, is_directory, std::string{event->name});
+					}
+					else if (event->mask & (IN_DELETE | IN_MOVED_FROM))
+					{
+						events.emplace_back(EventCategory::REMOVED, is_directory, std::string{event->name});
+					}
+				}
+			}
+#else
+			std::ignore = events;
+#endif
+		}
+	};
+
+	class FileBrowser::ListingCache final
+	{
+	public:
+		ListingCache(const ListingCache&) noexcept = delete;
+		ListingCache(ListingCache&&) noexcept = delete;
+		auto operator=(const ListingCache&) noexcept -> ListingCache& = delete;
+		auto operator=(ListingCache&&) noexcept -> ListingCache& = delete;
+
+		using listing_type = file_listing;
+
+		constexpr static std::size_t default_capacity = 64 * 1024 * 1024;
+
+	private:
+		struct entry_type
+		{
+			std::filesystem::path key;
+			directory_stamp stamp;
+			// the sort keys depend on it
+			SortOrder sort_order;
+			// the parent folder path is included (first entry)
+			std::shared_ptr<const listing_type> listing;
+			std::size_t bytes;
+		};
+
+		using entries_type = std::list<entry_type>;
+
+		std::mutex mutex_;
+		// front: most recently used
+		entries_type entries_;
+		std::unordered_map<std::filesystem::path, entries_type::iterator> index_;
+
+		std::size_t capacity_;
+		std::size_t bytes_;
+
+		ListingCache() noexcept
+			: capacity_{default_capacity},
+			  bytes_{0} {}
+
+		auto erase(const entries_type::iterator it) noexcept -> void
+		{
+			bytes_ -= it->bytes;
+			index_.erase(it->key);
+			entries_.erase(it);
+		}
+
+		auto evict() noexcept -> void
+		{
+			while (bytes_ > capacity_)
+			{
+				erase(std::prev(entries_.end()));
+			}
+		}
+
+	public:
+		[[nodiscard]] static auto instance() noexcept -> ListingCache&
+		{
+			// never destroyed, the background workers may still use it during the static destruction
+			static auto* cache = new ListingCache{};
+			return *cache;
+		}
+
+		[[nodiscard]] static auto make_key(const std::filesystem::path& directory) noexcept -> std::filesystem::path
+		{
+			std::error_code error_code{};
+
+			if (auto path = std::filesystem::canonical(directory, error_code);
+				not error_code)
+			{
+				return path;
+			}
+
+			return directory.lexically_normal();
+		}
+
+		[[nodiscard]] static auto make_stamp(const std::filesystem::path& directory, directory_stamp& stamp) noexcept -> bool
+		{
+#if defined(IMFB_PLATFORM_LINUX) or defined(IMFB_PLATFORM_DARWIN)
+			struct stat status{};
+			if (::stat(directory.c_str(), &status) != 0)
+			{
+				return false;
+			}
+
+#if defined(IMFB_PLATFORM_LINUX)
+			const auto& last_write_time = status.st_mtim;
+			const auto& last_status_change_time = status.st_ctim;
+#else
+			const auto& last_write_time = status.st_mtimespec;
+			const auto& last_status_change_time = status.st_ctimespec;
+#endif
+
+			stamp.last_write_time = static_cast<std::int64_t>(last_write_time.tv_sec) * 1'000'000'000 + last_write_time.tv_nsec;
+			stamp.last_status_change_time = static_cast<std::int64_t>(last_status_change_time.tv_sec) * 1'000'000'000 + last_status_change_time.tv_nsec;
+#else
+			std::error_code error_code{};
+
+			const auto last_write_time = std::filesystem::last_write_time(directory, error_code);
+			if (error_code)
+			{
+				return false;
+			}
+
+			stamp.last_write_time = last_write_time.time_since_epoch().count();
+			stamp.last_status_change_time = 0;
+#endif
+
+			return true;
+		}
+
+		// nullptr if not cached or outdated
+		[[nodiscard]] auto find(const std::filesystem::path& key, const directory_stamp& stamp, const SortOrder sort_order) noexcept -> std::shared_ptr<const listing_type>
+		{
+			std::scoped_lock lock{mutex_};
+
+			const auto it = index_.find(key);
+			if (it == index_.end())
+			{
+				return nullptr;
+			}
+
+			const auto entry = it->second;
+			if (entry->stamp != stamp)
+			{
+				erase(entry);
+				return nullptr;
+			}
+
+			// still valid, but not usable by this FileBrowser
+			if (entry->sort_order != sort_order)
+			{
+				return nullptr;
+			}
+
+			entries_.splice(entries_.begin(), entries_, entry);
+			return entry->listing;
+		}
+
+		auto insert(
+			const std::filesystem::path& key,
+			const directory_stamp& stamp,
+			const SortOrder sort_order,
+			const listing_type& listing
+		) noexcept -> void
+		{
+			const auto bytes = sizeof(entry_type) + listing.bytes();
+
+			std::scoped_lock lock{mutex_};
+
+			if (const auto it = index_.find(key);
+				it != index_.end())
+			{
+				erase(it->second);
+			}
+
+			if (bytes > capacity_)
+			{
+				return;
+			}
+
+			auto copy = std::make_shared<listing_type>(listing);
+			// the selection belongs to the FileBrowser
+			copy->select_none();
+			// the fetcher of the current FileBrowser will not answer the others
+			std::ranges::for_each(
+				copy->descriptors,
+				[](file_descriptor& descriptor) noexcept -> void
+				{
+					if (descriptor.metadata_state == MetadataState::PENDING)
+					{
+						descriptor.metadata_state = MetadataState::NONE;
+					}
+				}
+			);
+
+			entries_.emplace_front(key, stamp, sort_order, std::move(copy), bytes);
+			index_.emplace(key, entries_.begin());
+			bytes_ += bytes;
+
+			evict();
+		}
+
+		auto set_capacity(const std::size_t bytes) noexcept -> void
+		{
+			std::scoped_lock lock{mutex_};
+
+			capacity_ = bytes;
+			evict();
+		}
+
+		auto clear() noexcept -> void
+		{
+			std::scoped_lock lock{mutex_};
+
+			entries_.clear();
+			index_.clear();
+			bytes_ = 0;
+		}
+	};
+
+	class FileBrowser::DirectoryPrefetcher final : public std::enable_shared_from_this<DirectoryPrefetcher>
+	{
+	public:
+		// number of directories listed at the same time
+		constexpr static std::size_t max_workers = 2;
+		// the oldest requests are dropped (the user hovered something else in the meantime)
+		constexpr static std::size_t max_pending_requests = 8;
+
+	private:
+		struct request_type
+		{
+			std::filesystem::path directory;
+			SortOrder sort_order;
+			std::stop_token stop_token;
+		};
+
+		std::mutex mutex_;
+
+		std::deque<request_type> requests_;
+		std::size_t workers_;
+
+		// replaced on every cancellation
+		std::stop_source stop_source_;
+
+		static auto lower_thread_priority() noexcept -> void
+		{
+#if defined(IMFB_PLATFORM_LINUX)
+			// the nice value is per thread on linux
+			::setpriority(PRIO_PROCESS, static_cast<id_t>(::syscall(SYS_gettid)), 19);
+#endif
+		}
+
+		static auto prefetch(const request_type& request) noexcept -> void
+		{
+			auto& cache = ListingCache::instance();
+
+			directory_stamp stamp{};
+			if (not ListingCache::make_stamp(request.directory, stamp))
+			{
+				return;
+			}
+
+			const auto key = ListingCache::make_key(request.directory);
+			if (cache.find(key, stamp, request.sort_order))
+			{
+				return;
+			}
+
+			file_listing listing{};
+			listing.push_parent();
+			std::string tooltip{};
+
+			DirectoryScanner::enumerate(
+				request.directory,
+				request.sort_order,
+				request.stop_token,
+				tooltip,
+				listing
+			);
+
+			// an incomplete (cancelled) or broken listing is not cached, the FileBrowser will report the error itself
+			if (request.stop_token.stop_requested() or not tooltip.empty())
+			{
+				return;
+			}
+
+			DirectoryScanner::sort(listing, 1);
+			cache.insert(key, stamp, request.sort_order, listing);
+		}
+
+		auto run() noexcept -> void
+		{
+			lower_thread_priority();
+
+			while (true)
+			{
+				request_type request{};
+				{
+					std::scoped_lock lock{mutex_};
+
+					if (requests_.empty())
+					{
+						workers_ -= 1;
+						return;
+					}
+
+					request = std::move(requests_.front());
+					requests_.pop_front();
+				}
+
+				if (not request.stop_token.stop_requested())
+				{
+					prefetch(request);
+				}
+			}
+		}
+
+	public:
+		DirectoryPrefetcher() noexcept
+			: workers_{0} {}
+
+		auto request(const std::filesystem::path& directory, const SortOrder sort_order) noexcept -> void
+		{
+			std::scoped_lock lock{mutex_};
+
+			if (std::ranges::contains(requests_, directory, &request_type::directory))
+			{
+				return;
+			}
+
+			if (requests_.size() == max_pending_requests)
+			{
+				requests_.pop_front();
+			}
+			requests_.emplace_back(directory, sort_order, stop_source_.get_token());
+
+			if (workers_ < max_workers)
+			{
+				workers_ += 1;
+
+				// same as DirectoryScanner, the worker holds the prefetcher until the queue is drained
+				std::thread{
+						[self = shared_from_this()]() noexcept -> void
+						{
+							self->run();
+						}
+				}.detach();
+			}
+		}
+
+		// stop the running listings and drop the pending requests
+		auto cancel() noexcept -> void
+		{
+			std::scoped_lock lock{mutex_};
+
+			stop_source_.request_stop();
+			stop_source_ = {};
+
+			requests_.clear();
+		}
+	};
+
+	class FileBrowser::ThumbnailLoader final : public std::enable_shared_from_this<ThumbnailLoader>
+	{
+	public:
+		// number of images decoded at the same time
+		constexpr static std::size_t max_workers = 4;
+
+		struct request_type
+		{
+			std::string key;
+			std::filesystem::path path;
+		};
+
+		struct result_type
+		{
+			std::string key;
+			ThumbnailState state;
+			thumbnail_image_type image;
+		};
+
+	private:
+		std::shared_ptr<ThumbnailProvider> provider_;
+		std::uint32_t size_;
+
+		std::mutex mutex_;
+
+		std::deque<request_type> requests_;
+		std::vector<result_type> results_;
+		std::size_t workers_;
+
+		auto run() noexcept -> void
+		{
+			while (true)
+			{
+				request_type request{};
+				{
+					std::scoped_lock lock{mutex_};
+
+					if (requests_.empty())
+					{
+						workers_ -= 1;
+						return;
+					}
+
+					request = std::move(requests_.front());
+					requests_.pop_front();
+				}
+
+				result_type result{.key = std::move(request.key), .state = ThumbnailState::UNAVAILABLE, .image = {}};
+				if (provider_->decode(request.path, size_, result.image) and result.image.width != 0 and result.image.height != 0)
+				{
+					result.state = ThumbnailState::READY;
+				}
+
+				std::scoped_lock lock{mutex_};
+				results_.push_back(std::move(result));
+			}
+		}
+
+	public:
+		ThumbnailLoader(std::shared_ptr<ThumbnailProvider> provider, const std::uint32_t size) noexcept
+			: provider_{std::move(provider)},
+			  size_{size},
+			  workers_{0} {}
+
+		// the requests are moved out (the vector keeps its capacity)
+		auto submit(std::vector<std::pair<std::string, std::filesystem::path>>& requests) noexcept -> void
+		{
+			std::scoped_lock lock{mutex_};
+
+			for (auto& [key, path]: requests)
+			{
+				requests_.emplace_back(std::move(key), std::move(path));
+			}
+			requests.clear();
+
+			const auto workers = std::ranges::min(max_workers, requests_.size());
+			for (; workers_ < workers; ++workers_)
+			{
+				// same as DirectoryPrefetcher, the worker holds the loader until the queue is drained
+				std::thread{
+						[self = shared_from_this()]() noexcept -> void
+						{
+							self->run();
+						}
+				}.detach();
+			}
+		}
+
+		// the queued requests are reported as dropped, the running decodes still complete
+		auto drop() noexcept -> void
+		{
+			std::scoped_lock lock{mutex_};
+
+			for (auto& request: requests_)
+			{
+				results_.emplace_back(std::move(request.key), ThumbnailState::DROPPED, thumbnail_image_type{});
+			}
+			requests_.clear();
+		}
+
+		[[nodiscard]] auto has_results() noexcept -> bool
+		{
+			std::scoped_lock lock{mutex_};
+
+			return not results_.empty();
+		}
+
+		auto poll(std::vector<result_type>& results) noexcept -> void
+		{
+			std::scoped_lock lock{mutex_};
+
+			results.swap(results_);
+		}
+	};
+
+	class FileBrowser::ThumbnailCache final
+	{
+	public:
+		struct entry_type
+		{
+			std::string key;
+			ThumbnailState state;
+			thumbnail_texture_type texture;
+			std::uint32_t width;
+			std::uint32_t height;
+			// accounted against the capacity
+			std::size_t bytes;
+		};
+
+	private:
+		using entries_type = std::list<entry_type>;
+
+		thumbnail_release_type release_;
+		std::size_t capacity_;
+		std::size_t bytes_;
+
+		// front: most recently drawn
+		entries_type entries_;
+		// the keys point into entries_ (the nodes never move)
+		std::unordered_map<std::string_view, entries_type::iterator> index_;
+
+		[[nodiscard]] static auto bytes_of(const entry_type& entry) noexcept -> std::size_t
+		{
+			return sizeof(entry_type) + entry.key.size() + static_cast<std::size_t>(entry.width) * entry.height * 4;
+		}
+
+		auto erase(const entries_type::iterator it) noexcept -> entries_type::iterator
+		{
+			if (it->state == ThumbnailState::READY and release_)
+			{
+				release_(it->texture);
+			}
+
+			bytes_ -= it->bytes;
+			index_.erase(it->key);
+			return entries_.erase(it);
+		}
+
+	public:
+		ThumbnailCache(const ThumbnailCache&) noexcept = delete;
+		ThumbnailCache(ThumbnailCache&&) noexcept = delete;
+		auto operator=(const ThumbnailCache&) noexcept -> ThumbnailCache& = delete;
+		auto operator=(ThumbnailCache&&) noexcept -> ThumbnailCache& = delete;
+
+		ThumbnailCache(thumbnail_release_type release, const std::size_t capacity) noexcept
+			: release_{std::move(release)},
+			  capacity_{capacity},
+			  bytes_{0} {}
+
+		~ThumbnailCache() noexcept
+		{
+			clear();
+		}
+
+		// the entry becomes the most recently used one, nullptr if it is not cached
+		[[nodiscard]] auto find(const std::string_view key) noexcept -> const entry_type*
+		{
+			const auto it = index_.find(key);
+			if (it == index_.end())
+			{
+				return nullptr;
+			}
+
+			entries_.splice(entries_.begin(), entries_, it->second);
+			return std::to_address(it->second);
+		}
+
+		// a pending entry, resolved once the loader reports it
+		auto insert(const std::string_view key) noexcept -> void
+		{
+			auto& entry = entries_.emplace_front(std::string{key}, ThumbnailState::PENDING, thumbnail_texture_type{0}, 0, 0, 0);
+			entry.bytes = bytes_of(entry);
+
+			bytes_ += entry.bytes;
+			index_.emplace(entry.key, entries_.begin());
+		}
+
+		// nullptr if the entry was evicted or cleared in the meantime
+		[[nodiscard]] auto find_pending(const std::string_view key) noexcept -> entry_type*
+		{
+			const auto it = index_.find(key);
+			if (it == index_.end() or it->second->state != ThumbnailState::PENDING)
+			{
+				return nullptr;
+			}
+
+			return std::to_address(it->second);
+		}
+
+		auto resolve(entry_type& entry, const ThumbnailState state, const thumbnail_texture_type texture, const std::uint32_t width, const std::uint32_t height) noexcept -> void
+		{
+			if (state == ThumbnailState::DROPPED)
+			{
+				// requested again once visible
+				erase(index_.find(entry.key)->second);
+				return;
+			}
+
+			bytes_ -= entry.bytes;
+
+			entry.state = state;
+			entry.texture = texture;
+			entry.width = width;
+			entry.height = height;
+			entry.bytes = bytes_of(entry);
+
+			bytes_ += entry.bytes;
+		}
+
+		auto set_capacity(const std::size_t capacity) noexcept -> void
+		{
+			capacity_ = capacity;
+		}
+
+		// release the least recently drawn thumbnails until the cache fits in its capacity, the pending entries are kept
+		auto evict() noexcept -> void
+		{
+			for (auto it = entries_.end(); bytes_ > capacity_ and it != entries_.begin();)
+			{
+				--it;
+
+				if (it->state != ThumbnailState::PENDING)
+				{
+					it = erase(it);
+				}
+			}
+		}
+
+		auto clear() noexcept -> void
+		{
+			if (release_)
+			{
+				for (const auto& entry: entries_)
+				{
+					if (entry.state == ThumbnailState::READY)
+					{
+						release_(entry.texture);
+					}
+				}
+			}
+
+			index_.clear();
+			entries_.clear();
+			bytes_ = 0;
+		}
+	};
+
+	auto FileBrowser::has_state(const StateCategory state) const noexcept -> bool
+	{
+#if IMFB_DEBUG
+		switch (state)
+		{
+			case StateCategory::NONE:
+			{
+				std::unreachable();
+			}
+			case StateCategory::POSITION_DIRTY:
+			{
+				return states_.position_dirty;
+			}
+			case StateCategory::SCANNING:
+			{
+				return states_.scanning;
+			}
+			case StateCategory::SCAN_LIMITED:
+			{
+				return states_.scan_limited;
+			}
+			case StateCategory::SORT_DIRTY:
+			{
+				return states_.sort_dirty;
+			}
+			case StateCategory::VIEW_DIRTY:
+			{
+				return states_.view_dirty;
+			}
+			case StateCategory::REDRAW_REQUIRED:
+			{
+				return states_.redraw_required;
+			}
+			case StateCategory::OPENING:
+			{
+				return states_.window_opening;
+			}
+			case StateCategory::CLOSING:
+			{
+				return states_.window_closing;
+			}
+			case StateCategory::OPENED:
+			{
+				return states_.window_opened;
+			}
+			case StateCategory::SELECTED:
+			{
+				return states_.selected;
+			}
+			case StateCategory::FOCUSING_EDITOR_NEXT_FRAME:
+			{
+				return states_.focusing_editor_next_frame;
+			}
+			case StateCategory::SET_WORKING_DIRECTORY_NEXT_FRAME:
+			{
+				return states_.set_working_directory_next_frame;
+			}
+			case StateCategory::DELETE_SELECTED_NEXT_FRAME:
+			{
+				return states_.delete_selected_next_frame;
+			}
+			case StateCategory::SETTING_WORKING_DIRECTORY:
+			{
+				return states_.setting_working_directory;
+			}
+			case StateCategory::CREATING_FILE:
+			{
+				return states_.creating_file;
+			}
+			case StateCategory::CREATING_DIRECTORY:
+			{
+				return states_.creating_directory;
+			}
+			case StateCategory::CREATING:
+			{
+				return states_.creating_file or states_.creating_directory;
+			}
+			case StateCategory::RENAMING_FILE:
+			{
+				return states_.renaming_file;
+			}
+			case StateCategory::RENAMING_DIRECTORY:
+			{
+				return states_.renaming_directory;
+			}
+			case StateCategory::RENAMING:
+			{
+				return states_.renaming_file or states_.renaming_directory;
+			}
+			default:
+			{
+				std::unreachable();
+			}
+		}
+#else
+		assert(state != StateCategory::NONE);
+
+		return std::to_underlying(states_) & std::to_underlying(state);
+#endif
+	}
+
+	auto FileBrowser::append_state(const StateCategory state) noexcept -> void
+	{
+#if IMFB_DEBUG
+		switch (state)
+		{
+			case StateCategory::NONE:
+			{
+				std::unreachable();
+			}
+			case StateCategory::POSITION_DIRTY:
+			{
+				states_.position_dirty = 1;
+				break;
+			}
+			case StateCategory::SCANNING:
+			{
+				states_.scanning = 1;
+				break;
+			}
+			case StateCategory::SCAN_LIMITED:
+			{
+				states_.scan_limited = 1;
+				break;
+			}
+			case StateCategory::SORT_DIRTY:
+			{
+				states_.sort_dirty = 1;
+				break;
+			}
+			case StateCategory::VIEW_DIRTY:
+			{
+				states_.view_dirty = 1;
+				break;
+			}
+			case StateCategory::REDRAW_REQUIRED:
+			{
+				states_.redraw_required = 1;
+				break;
+			}
+			case StateCategory::OPENING:
+			{
+				states_.window_opening = 1;
+				break;
+			}
+			case StateCategory::CLOSING:
+			{
+				states_.window_closing = 1;
+				break;
+			}
+			case StateCategory::OPENED:
+			{
+				states_.window_opened = 1;
+				break;
+			}
+			case StateCategory::SELECTED:
+			{
+				states_.selected = 1;
+				break;
+			}
+			case StateCategory::FOCUSING_EDITOR_NEXT_FRAME:
+			{
+				states_.focusing_editor_next_frame = 1;
+				break;
+			}
+			case StateCategory::SET_WORKING_DIRECTORY_NEXT_FRAME:
+			{
+				states_.set_working_directory_next_frame = 1;
+				break;
+			}
+			case StateCategory::DELETE_SELECTED_NEXT_FRAME:
+			{
+				states_.delete_selected_next_frame = 1;
+				break;
+			}
+			case StateCategory::SETTING_WORKING_DIRECTORY:
+			{
+				states_.setting_working_directory = 1;
+				break;
+			}
+			case StateCategory::CREATING_FILE:
+			{
+				states_.creating_file = 1;
+				break;
+			}
+			case StateCategory::CREATING_DIRECTORY:
+			{
+				states_.creating_directory = 1;
+				break;
+			}
+			case StateCategory::CREATING:
+			{
+				std::unreachable();
+			}
+			case StateCategory::RENAMING_FILE:
+			{
+				states_.renaming_file = 1;
+				break;
+			}
+			case StateCategory::RENAMING_DIRECTORY:
+			{
+				states_.renaming_directory = 1;
+				break;
+			}
+			case StateCategory::RENAMING:
+			{
+				std::unreachable();
+			}
+			default:
+			{
+				std::unreachable();
+			}
+		}
+#else
+		assert(state != StateCategory::NONE);
+		assert(state != StateCategory::CREATING);
+		assert(state != StateCategory::RENAMING);
+
+		states_ = static_cast<StateCategory>(std::to_underlying(states_) | std::to_underlying(state));
+#endif
+	}
+
+	auto FileBrowser::clear_state(const StateCategory state) noexcept -> void
+	{
+#if IMFB_DEBUG
+		switch (state)
+		{
+			case StateCategory::NONE:
+			{
+				std::unreachable();
+			}
+			case StateCategory::POSITION_DIRTY:
+			{
+				states_.position_dirty = 0;
+				break;
+			}
+			case StateCategory::SCANNING:
+			{
+				states_.scanning = 0;
+				break;
+			}
+			case StateCategory::SCAN_LIMITED:
+			{
+				states_.scan_limited = 0;
+				break;
+			}
+			case StateCategory::SORT_DIRTY:
+			{
+				states_.sort_dirty = 0;
+				break;
+			}
+			case StateCategory::VIEW_DIRTY:
+			{
+				states_.view_dirty = 0;
+				break;
+			}
+			case StateCategory::REDRAW_REQUIRED:
+			{
+				states_.redraw_required = 0;
+				break;
+			}
 			case StateCategory::OPENING:
 			{
-				states_.window_opening = 1;
-				break;
+				states_.window_opening = 0;
+				break;
+			}
+			case StateCategory::CLOSING:
+			{
+				states_.window_closing = 0;
+				break;
+			}
+			case StateCategory::OPENED:
+			{
+				states_.window_opened = 0;
+				break;
+			}
+			case StateCategory::SELECTED:
+			{
+				states_.selected = 0;
+				break;
+			}
+			case StateCategory::FOCUSING_EDITOR_NEXT_FRAME:
+			{
+				states_.focusing_editor_next_frame = 0;
+				break;
+			}
+			case StateCategory::SET_WORKING_DIRECTORY_NEXT_FRAME:
+			{
+				states_.set_working_directory_next_frame = 0;
+				break;
+			}
+			case StateCategory::DELETE_SELECTED_NEXT_FRAME:
+			{
+				states_.delete_selected_next_frame = 0;
+				break;
+			}
+			case StateCategory::SETTING_WORKING_DIRECTORY:
+			{
+				states_.setting_working_directory = 0;
+				break;
+			}
+			case StateCategory::CREATING_FILE:
+			{
+				states_.creating_file = 0;
+				break;
+			}
+			case StateCategory::CREATING_DIRECTORY:
+			{
+				states_.creating_directory = 0;
+				break;
+			}
+			case StateCategory::CREATING:
+			{
+				states_.creating_file = 0;
+				states_.creating_directory = 0;
+				break;
+			}
+			case StateCategory::RENAMING_FILE:
+			{
+				states_.renaming_file = 0;
+				break;
+			}
+			case StateCategory::RENAMING_DIRECTORY:
+			{
+				states_.renaming_directory = 0;
+				break;
+			}
+			case StateCategory::RENAMING:
+			{
+				states_.renaming_file = 0;
+				states_.renaming_directory = 0;
+				break;
+			}
+			default:
+			{
+				std::unreachable();
+			}
+		}
+#else
+		assert(state != StateCategory::NONE);
+
+		states_ = static_cast<StateCategory>(std::to_underlying(states_) & ~std::to_underlying(state));
+#endif
+	}
+
+	auto FileBrowser::is_state_editing() const noexcept -> bool
+	{
+		return
+				has_state(StateCategory::SETTING_WORKING_DIRECTORY) or
+				has_state(StateCategory::CREATING) or
+				has_state(StateCategory::RENAMING);
+	}
+
+	auto FileBrowser::is_filter_matched(const std::string_view extension) const noexcept -> bool
+	{
+		if (filters_.empty())
+		{
+			return true;
+		}
+
+		return filter_matchers_[selected_filter_].match_extension(extension);
+	}
+
+	auto FileBrowser::is_filter_matched(const std::uint32_t extension) const noexcept -> bool
+	{
+		// interned after the last update_filter_mask (e.g. by the directory watcher)
+		if (extension >= filter_mask_size_)
+		{
+			return is_filter_matched(std::string_view{file_descriptors_.extensions[extension]});
+		}
+
+		return (filter_mask_[extension / 64] >> (extension % 64)) & 1;
+	}
+
+	auto FileBrowser::is_file_descriptor_matched(const std::size_t index) const noexcept -> bool
+	{
+		if (is_filter_matched(file_descriptors_.descriptors[index].extension))
+		{
+			return true;
+		}
+
+		assert(not filters_.empty());
+
+		// ".tar.gz" / "*_normal.png", the extension alone does not tell
+		const auto& matcher = filter_matchers_[selected_filter_];
+		return matcher.has_globs() and matcher.match_globs(file_descriptors_.name(index));
+	}
+
+	auto FileBrowser::update_filter_mask() noexcept -> void
+	{
+		const auto& extensions = file_descriptors_.extensions;
+
+		if (filter_mask_size_ == extensions.size())
+		{
+			return;
+		}
+
+		filter_mask_.resize((extensions.size() + 63) / 64);
+		// the matched entries may change (new extensions, or the whole mask is compiled again)
+		append_state(StateCategory::VIEW_DIRTY);
+
+		for (auto extension = filter_mask_size_; extension < extensions.size(); ++extension)
+		{
+			const auto bit = std::uint64_t{1} << (extension % 64);
+
+			if (is_filter_matched(std::string_view{extensions[extension]}))
+			{
+				filter_mask_[extension / 64] |= bit;
+			}
+			else
+			{
+				filter_mask_[extension / 64] &= ~bit;
+			}
+		}
+
+		filter_mask_size_ = extensions.size();
+	}
+
+	auto FileBrowser::reset_filter_mask() noexcept -> void
+	{
+		filter_mask_size_ = 0;
+		append_state(StateCategory::VIEW_DIRTY);
+		append_state(StateCategory::REDRAW_REQUIRED);
+	}
+
+	auto FileBrowser::update_file_descriptors() noexcept -> void
+	{
+		cancel_file_descriptors_scanning();
+
+		// the indices do not survive the refresh, reselect the entries by name once they are listed again
+		if (file_descriptors_.selected_count() != 0)
+		{
+			for (std::size_t index = file_descriptors_.first_selected(); index < file_descriptors_.size(); ++index)
+			{
+				if (file_descriptors_.is_selected(index))
+				{
+					reselected_filenames_.emplace_back(file_descriptors_.name(index), file_descriptors_.descriptors[index].is_directory);
+				}
 			}
-			case StateCategory::CLOSING:
+		}
+
+		file_descriptors_.clear();
+		watched_names_.clear();
+		// the extensions are interned again
+		reset_filter_mask();
+		append_state(StateCategory::REDRAW_REQUIRED);
+		bump_file_descriptors_generation();
+
+		// watch before enumerating, so no change is missed (duplicates are ignored)
+		if (has_flag(FileBrowserFlags::WATCH_DIRECTORY))
+		{
+			directory_watcher_ = std::make_shared<DirectoryWatcher>(working_directory_);
+		}
+		else
+		{
+			directory_watcher_.reset();
+		}
+
+		file_descriptors_.push_parent();
+
+		if (directory_prefetcher_)
+		{
+			// the user moved away, the hovered directories of the previous working directory are not interesting anymore
+			directory_prefetcher_->cancel();
+		}
+		if (has_flag(FileBrowserFlags::PREFETCH_DIRECTORIES))
+		{
+			if (auto parent_path = working_directory_.parent_path();
+				parent_path != working_directory_)
 			{
-				states_.window_closing = 1;
-				break;
+				prefetch_directory(parent_path);
 			}
-			case StateCategory::OPENED:
+		}
+
+		listing_cache_key_.clear();
+		if (is_listing_cached() and IMFB_STATISTICS_CALL(StatisticsPhase::FILESYSTEM_STATUS, ListingCache::make_stamp(working_directory_, listing_cache_stamp_)))
+		{
+			listing_cache_key_ = ListingCache::make_key(working_directory_);
+
+			if (const auto listing = ListingCache::instance().find(listing_cache_key_, listing_cache_stamp_, get_sort_order()))
 			{
-				states_.window_opened = 1;
-				break;
+				// the parent folder path is included
+				file_descriptors_ = *listing;
+				reselect_file_descriptors();
+				reselected_filenames_.clear();
+				return;
 			}
-			case StateCategory::SELECTED:
+		}
+
+		const auto limit = scan_limit_ == 0 ? DirectoryScanner::unlimited : scan_limit_;
+		directory_scanner_ = std::make_shared<DirectoryScanner>(working_directory_, get_sort_order(), limit);
+
+		if (has_flag(FileBrowserFlags::ASYNC_SCAN))
+		{
+			directory_scanner_->start();
+
+			append_state(StateCategory::SCANNING);
+			return;
+		}
+
+		std::string tooltip{};
+
+		const auto finished = IMFB_STATISTICS_CALL(StatisticsPhase::FILESYSTEM_LIST, directory_scanner_->step(tooltip, limit, file_descriptors_));
+
+		if (not tooltip.empty())
+		{
+			tooltip_ = std::move(tooltip);
+		}
+
+		// drop parent folder path
+		DirectoryScanner::sort(file_descriptors_, 1);
+		reselect_file_descriptors();
+
+		if (finished)
+		{
+			directory_scanner_.reset();
+			reselected_filenames_.clear();
+			cache_file_descriptors();
+		}
+		else
+		{
+			// keep the scanner (no worker), the enumeration continues where it stopped
+			append_state(StateCategory::SCAN_LIMITED);
+		}
+	}
+
+	auto FileBrowser::poll_file_descriptors() noexcept -> void
+	{
+		if (not directory_scanner_)
+		{
+			return;
+		}
+
+		std::vector<file_listing> batches{};
+		std::string tooltip{};
+
+		const auto state = directory_scanner_->poll(batches, tooltip);
+
+		if (not batches.empty() or state != DirectoryScanner::ScanState::RUNNING)
+		{
+			append_state(StateCategory::REDRAW_REQUIRED);
+		}
+
+		for (const auto& batch: batches)
+		{
+			const auto middle = file_descriptors_.size();
+
+			file_descriptors_.append(batch);
+			drop_watched_file_descriptors(middle);
+			merge_file_descriptors(middle);
+		}
+
+		if (not batches.empty())
+		{
+			reselect_file_descriptors();
+		}
+
+		if (state == DirectoryScanner::ScanState::LIMITED)
+		{
+			append_state(StateCategory::SCAN_LIMITED);
+		}
+		else if (state == DirectoryScanner::ScanState::FINISHED)
+		{
+			directory_scanner_.reset();
+			reselected_filenames_.clear();
+			watched_names_.clear();
+			clear_state(StateCategory::SCANNING);
+			clear_state(StateCategory::SCAN_LIMITED);
+
+			if (not tooltip.empty())
 			{
-				states_.selected = 1;
+				tooltip_ = std::move(tooltip);
+			}
+
+			cache_file_descriptors();
+		}
+	}
+
+	auto FileBrowser::cancel_file_descriptors_scanning() noexcept -> void
+	{
+		if (directory_scanner_)
+		{
+			// the worker thread drops its reference as soon as it notices the cancellation
+			directory_scanner_->cancel();
+			directory_scanner_.reset();
+		}
+
+		clear_state(StateCategory::SCANNING);
+		clear_state(StateCategory::SCAN_LIMITED);
+	}
+
+	auto FileBrowser::load_more_file_descriptors() noexcept -> void
+	{
+		if (not directory_scanner_ or not has_state(StateCategory::SCAN_LIMITED))
+		{
+			return;
+		}
+
+		clear_state(StateCategory::SCAN_LIMITED);
+
+		const auto count = scan_limit_ == 0 ? DirectoryScanner::unlimited : scan_limit_;
+
+		// the worker is waiting
+		if (has_state(StateCategory::SCANNING))
+		{
+			directory_scanner_->load_more(count);
+			return;
+		}
+
+		const auto middle = file_descriptors_.size();
+		std::string tooltip{};
+
+		const auto finished = IMFB_STATISTICS_CALL(StatisticsPhase::FILESYSTEM_LIST, directory_scanner_->step(tooltip, count, file_descriptors_));
+
+		if (not tooltip.empty())
+		{
+			tooltip_ = std::move(tooltip);
+		}
+
+		drop_watched_file_descriptors(middle);
+		DirectoryScanner::sort(file_descriptors_, middle);
+		merge_file_descriptors(middle);
+		reselect_file_descriptors();
+
+		if (finished)
+		{
+			directory_scanner_.reset();
+			reselected_filenames_.clear();
+			watched_names_.clear();
+			cache_file_descriptors();
+		}
+		else
+		{
+			append_state(StateCategory::SCAN_LIMITED);
+		}
+	}
+
+	auto FileBrowser::merge_file_descriptors(const std::size_t middle) noexcept -> void
+	{
+		if (middle == file_descriptors_.size())
+		{
+			return;
+		}
+
+		assert(file_descriptors_.size() <= std::numeric_limits<std::uint32_t>::max());
+
+		// merge the indices, then move each entry once
+		std::vector<std::uint32_t> order(file_descriptors_.size());
+		// parent folder path
+		order.front() = 0;
+
+		const auto less = [this](const std::uint32_t lhs, const std::uint32_t rhs) noexcept -> bool
+		{
+			return DirectoryScanner::less(file_descriptors_, lhs, rhs);
+		};
+
+		std::ranges::merge(
+			std::views::iota(std::uint32_t{1}, static_cast<std::uint32_t>(middle)),
+			std::views::iota(static_cast<std::uint32_t>(middle), static_cast<std::uint32_t>(file_descriptors_.size())),
+			order.begin() + 1,
+			less
+		);
+
+		file_descriptors_.permute(order);
+		bump_file_descriptors_revision();
+	}
+
+	auto FileBrowser::drop_watched_file_descriptors(const std::size_t middle) noexcept -> void
+	{
+		if (watched_names_.empty())
+		{
+			return;
+		}
+
+		// from the back, only the (few) entries after the erased one move
+		for (auto index = file_descriptors_.size(); index > middle; --index)
+		{
+			if (watched_names_.contains(file_descriptors_.name(index - 1)))
+			{
+				file_descriptors_.erase(index - 1);
+			}
+		}
+	}
+
+	auto FileBrowser::change_working_directory(std::filesystem::path directory) noexcept -> void
+	{
+		// stop loading the old directory right away, the listing itself is replaced next frame
+		cancel_file_descriptors_scanning();
+
+		if (directory_prefetcher_)
+		{
+			directory_prefetcher_->cancel();
+		}
+
+		// the selection belongs to the previous working directory
+		file_descriptors_.select_none();
+		reselected_filenames_.clear();
+
+		// so does the query
+		search_buffer_[0] = '\0';
+
+		working_directory_ = std::move(directory);
+		update_breadcrumb();
+		append_state(StateCategory::SET_WORKING_DIRECTORY_NEXT_FRAME);
+	}
+
+	auto FileBrowser::get_sort_order() const noexcept -> SortOrder
+	{
+		return has_flag(FileBrowserFlags::NATURAL_SORT) ? SortOrder::NATURAL : SortOrder::LEXICAL;
+	}
+
+	auto FileBrowser::sort_file_descriptors() noexcept -> void
+	{
+		// the pending batches are keyed with the previous order, start over
+		if (directory_scanner_)
+		{
+			update_file_descriptors();
+			return;
+		}
+
+		file_descriptors_.rebuild_sort_keys(get_sort_order());
+
+		// drop parent folder path
+		DirectoryScanner::sort(file_descriptors_, 1);
+		bump_file_descriptors_revision();
+	}
+
+	auto FileBrowser::order_file_descriptors() noexcept -> void
+	{
+		const auto start = std::chrono::steady_clock::now();
+		ScopeGuard cost_guard
+		{
+				[this, start]
+				{
+					file_descriptors_order_cost_ = std::chrono::steady_clock::now() - start;
+				}
+		};
+
+		clear_state(StateCategory::SORT_DIRTY);
+		append_state(StateCategory::VIEW_DIRTY);
+
+		assert(file_descriptors_.size() <= std::numeric_limits<std::uint32_t>::max());
+
+		// file_descriptors_ is already sorted by name (directories first)
+		file_descriptors_order_.resize(file_descriptors_.size());
+		std::iota(file_descriptors_order_.begin(), file_descriptors_order_.end(), std::uint32_t{0});
+
+		if (file_descriptors_order_.size() <= 2 or sort_specs_.empty())
+		{
+			return;
+		}
+
+		if (sort_specs_.size() == 1 and sort_specs_.front().column == SortColumn::NAME and not sort_specs_.front().descending)
+		{
+			return;
+		}
+
+		// drop parent folder path
+		const auto order = std::span{file_descriptors_order_}.subspan(1);
+
+		// file_descriptors_ lists the directories first, the entries [1, directory_count] are the directories
+		const auto directory_count = static_cast<std::uint32_t>(
+			std::ranges::partition_point(
+				order,
+				[this](const std::uint32_t index) noexcept -> bool
+				{
+					return file_descriptors_.descriptors[index].is_directory;
+				}
+			) - order.begin()
+		);
+		const auto is_directory = [directory_count](const std::uint32_t index) noexcept -> bool
+		{
+			return index <= directory_count;
+		};
+
+		// the least significant spec reorders the listing directly (a walk over its column order), every other spec is a stable pass over the ranks
+		switch (const auto& spec = sort_specs_.back();
+			spec.column)
+		{
+			case SortColumn::NAME:
+			{
+				if (spec.descending)
+				{
+					std::ranges::reverse(order.first(directory_count));
+					std::ranges::reverse(order.subspan(directory_count));
+				}
 				break;
 			}
-			case StateCategory::FOCUSING_EDITOR_NEXT_FRAME:
+			case SortColumn::TYPE:
 			{
-				states_.focusing_editor_next_frame = 1;
+				// the direction only decides which group comes first
+				if (spec.descending)
+				{
+					std::ranges::rotate(order, order.begin() + directory_count);
+				}
 				break;
 			}
-			case StateCategory::SET_WORKING_DIRECTORY_NEXT_FRAME:
+			case SortColumn::EXTENSION:
+			case SortColumn::SIZE:
+			case SortColumn::LAST_WRITE_TIME:
 			{
-				states_.set_working_directory_next_frame = 1;
+				const auto& column_order = update_column_order(spec.column);
+
+				// directories first, both groups keep the order of the column
+				std::uint32_t directory_position = 0;
+				std::uint32_t file_position = directory_count;
+				const auto place = [&](const std::uint32_t index) noexcept -> void
+				{
+					order[is_directory(index) ? directory_position++ : file_position++] = index;
+				};
+
+				if (not spec.descending)
+				{
+					std::ranges::for_each(column_order.order, place);
+					break;
+				}
+
+				// the runs of equal values from the back, each run keeps the order of the listing
+				for (auto end = column_order.order.size(); end != 0;)
+				{
+					const auto rank = column_order.ranks[column_order.order[end - 1]];
+
+					auto begin = end - 1;
+					while (begin != 0 and column_order.ranks[column_order.order[begin - 1]] == rank)
+					{
+						begin -= 1;
+					}
+
+					std::ranges::for_each(std::span{column_order.order}.subspan(begin, end - begin), place);
+					end = begin;
+				}
 				break;
 			}
-			case StateCategory::DELETE_SELECTED_NEXT_FRAME:
+			default:
+			{
+				std::unreachable();
+			}
+		}
+
+		// least significant first, every pass is stable
+		for (const auto& spec: sort_specs_ | std::views::reverse | std::views::drop(1))
+		{
+			const std::uint32_t* ranks = nullptr;
+			// SortColumn::NAME: the index is the rank, SortColumn::TYPE: the group is the value
+			std::uint32_t max_rank = spec.column == SortColumn::NAME ? static_cast<std::uint32_t>(order.size()) : 0;
+
+			if (spec.column != SortColumn::NAME and spec.column != SortColumn::TYPE)
+			{
+				const auto& column_order = update_column_order(spec.column);
+
+				ranks = column_order.ranks.data();
+				max_rank = column_order.max_rank;
+			}
+
+			// the group bit right above the rank, so that the radix sort only runs over the bits that actually differ
+			const auto rank_bits = std::bit_width(max_rank);
+
+			order_keys_.resize(order.size());
+			for (std::size_t i = 0; i < order.size(); ++i)
+			{
+				const auto index = order[i];
+
+				const auto group = spec.column == SortColumn::TYPE ? is_directory(index) == spec.descending : not is_directory(index);
+				const auto rank = ranks != nullptr ? ranks[index] : (spec.column == SortColumn::NAME ? index : 0);
+
+				order_keys_[i] = (std::uint64_t{group} << rank_bits) | (spec.descending ? max_rank - rank : rank);
+			}
+
+			radix_sort(order_keys_, order, order_keys_buffer_, order_buffer_);
+		}
+	}
+
+	auto FileBrowser::update_column_order(const SortColumn column) noexcept -> const column_order&
+	{
+		assert(column == SortColumn::EXTENSION or column == SortColumn::SIZE or column == SortColumn::LAST_WRITE_TIME);
+
+		auto& column_order = column_orders_[std::to_underlying(column)];
+
+		// the extensions do not depend on the metadata
+		const auto metadata_revision = column == SortColumn::EXTENSION ? 0 : file_metadata_revision_;
+
+		if (
+			column_order.ranks.size() == file_descriptors_.size() and
+			column_order.revision == file_descriptors_revision_ and
+			column_order.metadata_revision == metadata_revision
+		)
+		{
+			return column_order;
+		}
+
+		column_order.revision = file_descriptors_revision_;
+		column_order.metadata_revision = metadata_revision;
+
+		// interned extension => rank (case-insensitive)
+		std::vector<std::uint32_t> extension_ranks{};
+
+		if (column == SortColumn::EXTENSION)
+		{
+			const auto& extensions = file_descriptors_.extensions;
+
+			std::vector<std::string> folded_extensions{};
+			folded_extensions.reserve(extensions.size());
+			for (const auto& extension: extensions)
+			{
+				auto& folded = folded_extensions.emplace_back(extension);
+				std::ranges::transform(folded, folded.begin(), to_lower);
+			}
+
+			std::vector<std::uint32_t> ids(extensions.size());
+			std::iota(ids.begin(), ids.end(), std::uint32_t{0});
+			std::ranges::sort(ids, std::ranges::less{}, [&](const std::uint32_t id) noexcept -> const std::string& { return folded_extensions[id]; });
+
+			// the same folded extension has the same rank
+			extension_ranks.resize(extensions.size());
+			for (std::uint32_t rank = 0, i = 0; i < ids.size(); ++i)
+			{
+				if (i != 0 and folded_extensions[ids[i]] != folded_extensions[ids[i - 1]])
+				{
+					rank += 1;
+				}
+
+				extension_ranks[ids[i]] = rank;
+			}
+		}
+
+		// the value of the column, ascending
+		const auto value_of = [&](const std::uint32_t index) noexcept -> std::uint64_t
+		{
+			const auto& descriptor = file_descriptors_.descriptors[index];
+			const auto& metadata = file_descriptors_.metadata[index];
+			const auto metadata_ready = descriptor.metadata_state == MetadataState::READY;
+
+			switch (column)
+			{
+				case SortColumn::EXTENSION:
+				{
+					return extension_ranks[descriptor.extension];
+				}
+				case SortColumn::SIZE:
+				{
+					// the size of a directory is meaningless, unknown sizes are treated as 0
+					return (metadata_ready and not descriptor.is_directory) ? metadata.size : 0;
+				}
+				case SortColumn::LAST_WRITE_TIME:
+				{
+					// signed => unsigned (same order)
+					return metadata_ready ? static_cast<std::uint64_t>(metadata.last_write_time.time_since_epoch().count()) ^ (std::uint64_t{1} << 63) : 0;
+				}
+				default:
+				{
+					std::unreachable();
+				}
+			}
+		};
+
+		// drop parent folder path
+		const auto size = static_cast<std::uint32_t>(file_descriptors_.size() - 1);
+
+		order_keys_.resize(size);
+		column_order.order.resize(size);
+
+		auto min_value = std::numeric_limits<std::uint64_t>::max();
+		for (std::uint32_t i = 0; i < size; ++i)
+		{
+			const auto value = value_of(i + 1);
+			min_value = std::ranges::min(min_value, value);
+
+			order_keys_[i] = value;
+			column_order.order[i] = i + 1;
+		}
+
+		// normalized, so that the radix sort only runs over the bits that actually differ
+		std::ranges::for_each(order_keys_, [min_value](std::uint64_t& key) noexcept -> void { key -= min_value; });
+
+		radix_sort(order_keys_, column_order.order, order_keys_buffer_, order_buffer_);
+
+		column_order.ranks.resize(file_descriptors_.size());
+		// parent folder path
+		column_order.ranks.front() = 0;
+
+		std::uint32_t rank = 0;
+		for (std::uint32_t i = 0; i < size; ++i)
+		{
+			if (i != 0 and order_keys_[i] != order_keys_[i - 1])
 			{
-				states_.delete_selected_next_frame = 1;
-				break;
+				rank += 1;
 			}
-			case StateCategory::SETTING_WORKING_DIRECTORY:
+
+			column_order.ranks[column_order.order[i]] = rank;
+		}
+		column_order.max_rank = rank;
+
+		return column_order;
+	}
+
+	auto FileBrowser::update_file_descriptors_view() noexcept -> void
+	{
+		if (not has_state(StateCategory::VIEW_DIRTY))
+		{
+			return;
+		}
+		clear_state(StateCategory::VIEW_DIRTY);
+
+		const auto hide_regular_files = has_flag(FileBrowserFlags::SELECT_DIRECTORY) and has_flag(FileBrowserFlags::HIDE_REGULAR_FILES);
+
+		file_descriptors_view_.clear();
+		file_descriptors_view_rows_.assign(file_descriptors_.size(), std::numeric_limits<std::uint32_t>::max());
+		// the rows moved
+		type_ahead_row_ = -1;
+
+		// FileBrowserFlags::SEARCH_BOX, the ranked matches replace the display order
+		for (const auto index: is_searching() ? search_ranked_ : file_descriptors_order_)
+		{
+			const auto& descriptor = file_descriptors_.descriptors[index];
+
+			if (not descriptor.is_directory)
 			{
-				states_.setting_working_directory = 1;
-				break;
+				if (hide_regular_files)
+				{
+					continue;
+				}
+
+				if (not is_file_descriptor_matched(index))
+				{
+					continue;
+				}
 			}
-			case StateCategory::CREATING_FILE:
+
+			file_descriptors_view_rows_[index] = static_cast<std::uint32_t>(file_descriptors_view_.size());
+			file_descriptors_view_.push_back(index);
+		}
+	}
+
+	auto FileBrowser::bump_file_descriptors_generation() noexcept -> void
+	{
+		file_descriptors_generation_ += 1;
+		bump_file_descriptors_revision();
+
+		if (metadata_fetcher_)
+		{
+			metadata_fetcher_->set_generation(file_descriptors_generation_);
+
+			std::ranges::for_each(
+				file_descriptors_.descriptors,
+				[](file_descriptor& descriptor) noexcept -> void
+				{
+					if (descriptor.metadata_state == MetadataState::PENDING)
+					{
+						descriptor.metadata_state = MetadataState::NONE;
+					}
+				}
+			);
+		}
+	}
+
+	auto FileBrowser::bump_file_descriptors_revision() noexcept -> void
+	{
+		file_descriptors_revision_ += 1;
+		metadata_sweep_cursor_ = 0;
+		prefetch_hovered_index_ = 0;
+
+		append_state(StateCategory::SORT_DIRTY);
+	}
+
+	auto FileBrowser::lower_bound_file_descriptor(const std::string_view sort_key, const bool is_directory) const noexcept -> std::size_t
+	{
+		// drop parent folder path
+		const auto indices = std::views::iota(std::size_t{1}, file_descriptors_.size());
+		const auto it = std::ranges::lower_bound(
+			indices,
+			std::pair<bool, std::string_view>{not is_directory, sort_key},
+			std::ranges::less{},
+			[this](const std::size_t index) noexcept -> std::pair<bool, std::string_view>
 			{
-				states_.creating_file = 1;
-				break;
+				return file_descriptors_.sort_key(index);
 			}
-			case StateCategory::CREATING_DIRECTORY:
+		);
+
+		return 1 + static_cast<std::size_t>(std::ranges::distance(indices.begin(), it));
+	}
+
+	auto FileBrowser::find_file_descriptor(const std::string_view name, const bool is_directory) const noexcept -> std::size_t
+	{
+		std::string sort_key{};
+		file_listing::append_sort_key(sort_key, name, get_sort_order());
+
+		// several entries may have the same case-insensitive name
+		for (auto index = lower_bound_file_descriptor(sort_key, is_directory); index < file_descriptors_.size(); ++index)
+		{
+			if (file_descriptors_.sort_key(index) != std::pair<bool, std::string_view>{not is_directory, sort_key})
 			{
-				states_.creating_directory = 1;
 				break;
 			}
-			case StateCategory::CREATING:
+
+			if (file_descriptors_.name(index) == name)
 			{
-				std::unreachable();
+				return index;
 			}
-			case StateCategory::RENAMING_FILE:
+		}
+
+		return file_descriptors_.size();
+	}
+
+	auto FileBrowser::is_searching() const noexcept -> bool
+	{
+		return has_flag(FileBrowserFlags::SEARCH_BOX) and not search_query_.empty();
+	}
+
+	auto FileBrowser::update_search_index() noexcept -> void
+	{
+		search_revision_ = file_descriptors_revision_;
+		search_size_ = file_descriptors_.size();
+
+		// at least twice the size of the names (without the "[DIR] " prefixes and the null terminators)
+		search_names_.resize(file_descriptors_.names.size() * 2);
+		search_offsets_.resize(file_descriptors_.size());
+		search_masks_.resize(file_descriptors_.size());
+
+		std::size_t offset = 0;
+		for (std::size_t index = 0; index < file_descriptors_.size(); ++index)
+		{
+			const auto name = file_descriptors_.name(index);
+
+			auto* copy = search_names_.data() + offset;
+			auto* folded = copy + name.size();
+
+			std::ranges::copy(name, copy);
+			std::ranges::transform(name, folded, to_lower);
+
+			search_offsets_[index] = static_cast<std::uint32_t>(offset);
+			search_masks_[index] = search_character_mask({folded, name.size()});
+
+			offset += name.size() * 2;
+		}
+		search_names_.resize(offset);
+	}
+
+	auto FileBrowser::update_search() noexcept -> void
+	{
+		if (not has_flag(FileBrowserFlags::SEARCH_BOX))
+		{
+			return;
+		}
+
+		// null-terminated
+		const std::string_view text{search_buffer_.data()};
+
+		if (text.empty() and search_query_.empty())
+		{
+			return;
+		}
+
+		const auto listing_changed = search_revision_ != file_descriptors_revision_ or search_size_ != file_descriptors_.size();
+		const auto query_changed = not std::ranges::equal(text, search_query_, std::ranges::equal_to{}, to_lower);
+
+		if (not listing_changed and not query_changed)
+		{
+			return;
+		}
+
+		IMFB_STATISTICS_SCOPE(StatisticsPhase::SEARCH);
+
+		append_state(StateCategory::VIEW_DIRTY);
+
+		// "ab" ==> "abc" / "a_b", the matches of the new query are a subset of the matches of the previous one
+		auto refined = not listing_changed and not search_query_.empty();
+		if (refined)
+		{
+			auto it = search_query_.begin();
+			for (const auto c: text)
 			{
-				states_.renaming_file = 1;
-				break;
+				if (it != search_query_.end() and *it == to_lower(c))
+				{
+					++it;
+				}
 			}
-			case StateCategory::RENAMING_DIRECTORY:
+
+			refined = it == search_query_.end();
+		}
+
+		// reserved, does not allocate
+		search_query_.clear();
+		std::ranges::transform(text, std::back_inserter(search_query_), to_lower);
+
+		if (search_query_.empty())
+		{
+			search_results_.clear();
+			search_ranked_.clear();
+			return;
+		}
+
+		if (listing_changed)
+		{
+			update_search_index();
+		}
+
+		const auto query_mask = search_character_mask(search_query_);
+
+		// the prefilter, one 64-bit test per candidate (instead of the name bytes), the survivors are compacted in place without a branch
+		std::size_t candidates = 0;
+		if (refined)
+		{
+			for (const auto index: search_results_)
 			{
-				states_.renaming_directory = 1;
-				break;
+				search_results_[candidates] = index;
+				candidates += (search_masks_[index] & query_mask) == query_mask;
 			}
-			case StateCategory::RENAMING:
+		}
+		else
+		{
+			// drop parent folder path
+			search_results_.resize(file_descriptors_.size());
+			for (std::uint32_t index = 1; index < file_descriptors_.size(); ++index)
 			{
-				std::unreachable();
+				search_results_[candidates] = index;
+				candidates += (search_masks_[index] & query_mask) == query_mask;
 			}
-			default:
+		}
+		search_results_.resize(candidates);
+
+		// the survivors are scored, the order of the listing is kept (the ties are ranked by name)
+		search_scores_.clear();
+
+		std::size_t matched = 0;
+		for (const auto index: search_results_)
+		{
+			const auto size = file_descriptors_.descriptors[index].name_size;
+			const std::string_view name{search_names_.data() + search_offsets_[index], size};
+			const std::string_view folded{name.data() + size, size};
+
+			if (const auto score = fuzzy_score(search_query_, folded, name);
+				score != 0)
 			{
-				std::unreachable();
+				search_results_[matched] = index;
+				matched += 1;
+				// best first
+				search_scores_.push_back(std::numeric_limits<std::uint32_t>::max() - score);
 			}
 		}
-#else
-		assert(state != StateCategory::NONE);
-		assert(state != StateCategory::CREATING);
-		assert(state != StateCategory::RENAMING);
+		search_results_.resize(matched);
 
-		states_ = static_cast<StateCategory>(std::to_underlying(states_) | std::to_underlying(state));
-#endif
+		search_ranked_.assign(search_results_.begin(), search_results_.end());
+		radix_sort(search_scores_, search_ranked_, search_scores_buffer_, search_ranked_buffer_);
 	}
 
-	auto FileBrowser::clear_state(const StateCategory state) noexcept -> void
+	auto FileBrowser::find_type_ahead_match() noexcept -> std::size_t
 	{
-#if IMFB_DEBUG
-		switch (state)
+		const auto sort_order = get_sort_order();
+		const std::string_view prefix{type_ahead_prefix_.data(), type_ahead_prefix_size_};
+
+		// SortOrder::NATURAL: the length of a digit run is encoded before its digits, the length of the trailing run is not known yet
+		auto digits_first = prefix.size();
+		if (sort_order == SortOrder::NATURAL)
 		{
-			case StateCategory::NONE:
+			while (digits_first != 0 and prefix[digits_first - 1] >= '0' and prefix[digits_first - 1] <= '9')
 			{
-				std::unreachable();
+				digits_first -= 1;
 			}
-			case StateCategory::POSITION_DIRTY:
+		}
+
+		type_ahead_key_.clear();
+		file_listing::append_sort_key(type_ahead_key_, prefix.substr(0, digits_first), sort_order);
+		const auto head_size = type_ahead_key_.size();
+
+		// {the first visible entry of the group starting with key, the lower bound of key}
+		// the filtered out matches are skipped (usually there are none)
+		const auto match = [this](const std::string_view key, const bool is_directory) noexcept -> std::pair<std::size_t, std::size_t>
+		{
+			const auto lower_bound = lower_bound_file_descriptor(key, is_directory);
+
+			for (auto index = lower_bound; index < file_descriptors_.size(); ++index)
 			{
-				states_.position_dirty = 0;
-				break;
+				if (const auto [group, sort_key] = file_descriptors_.sort_key(index);
+					group == is_directory or not sort_key.starts_with(key))
+				{
+					break;
+				}
+
+				if (index < file_descriptors_view_rows_.size() and file_descriptors_view_rows_[index] != std::numeric_limits<std::uint32_t>::max())
+				{
+					return {index, lower_bound};
+				}
 			}
-			case StateCategory::OPENING:
+
+			return {file_descriptors_.size(), lower_bound};
+		};
+
+		// directories first, same as the listing
+		for (const auto is_directory: {true, false})
+		{
+			if (digits_first == prefix.size())
 			{
-				states_.window_opening = 0;
-				break;
+				if (const auto [index, _] = match(type_ahead_key_, is_directory);
+					index != file_descriptors_.size())
+				{
+					return index;
+				}
+
+				continue;
 			}
-			case StateCategory::CLOSING:
+
+			// '0' + length + digits (without the leading zeros), see file_listing::append_sort_key
+			auto digits = prefix.substr(digits_first);
+			while (not digits.empty() and digits.front() == '0')
 			{
-				states_.window_closing = 0;
-				break;
+				digits.remove_prefix(1);
 			}
-			case StateCategory::OPENED:
+
+			// the typed digits lead a number of any length (the shorter numbers sort first), a run of zeros only matches 0
+			const auto max_length = digits.empty() ? std::size_t{0} : std::size_t{std::numeric_limits<std::uint32_t>::max()};
+			for (auto length = digits.size(); length <= max_length; ++length)
 			{
-				states_.window_opened = 0;
-				break;
+				type_ahead_key_.resize(head_size);
+				type_ahead_key_.push_back('0');
+				append_digit_run_length(type_ahead_key_, length);
+				type_ahead_key_.append(digits);
+
+				const auto [index, lower_bound] = match(type_ahead_key_, is_directory);
+				if (index != file_descriptors_.size())
+				{
+					return index;
+				}
+
+				// no longer number follows the head
+				if (lower_bound == file_descriptors_.size())
+				{
+					break;
+				}
+
+				if (const auto [group, sort_key] = file_descriptors_.sort_key(lower_bound);
+					group == is_directory or not sort_key.starts_with(std::string_view{type_ahead_key_}.substr(0, head_size + 1)))
+				{
+					break;
+				}
 			}
-			case StateCategory::SELECTED:
+		}
+
+		return file_descriptors_.size();
+	}
+
+	auto FileBrowser::update_type_ahead() noexcept -> void
+	{
+		const auto& io = ImGui::GetIO();
+
+		if (io.InputQueueCharacters.empty() or io.KeyCtrl or io.KeyAlt or io.KeySuper)
+		{
+			return;
+		}
+
+		if (not ImGui::IsWindowFocused() or ImGui::IsAnyItemActive())
+		{
+			return;
+		}
+
+		const auto now = ImGui::GetTime();
+		if (now - type_ahead_time_ > type_ahead_timeout)
+		{
+			type_ahead_prefix_size_ = 0;
+		}
+		type_ahead_time_ = now;
+
+		for (const auto character: io.InputQueueCharacters)
+		{
+			const auto c = static_cast<std::uint32_t>(character);
+
+			// space toggles the selection (ImGui::BeginMultiSelect), unless it is a part of the prefix
+			if (c < 0x20 or c == 0x7f or (c == ' ' and type_ahead_prefix_size_ == 0))
 			{
-				states_.selected = 0;
-				break;
+				continue;
 			}
-			case StateCategory::FOCUSING_EDITOR_NEXT_FRAME:
+
+			// utf-8, same as the names
+			std::array<char, 4> bytes{};
+			std::size_t size;
+			if (c < 0x80)
 			{
-				states_.focusing_editor_next_frame = 0;
-				break;
+				bytes[0] = static_cast<char>(c);
+				size = 1;
 			}
-			case StateCategory::SET_WORKING_DIRECTORY_NEXT_FRAME:
+			else if (c < 0x800)
 			{
-				states_.set_working_directory_next_frame = 0;
-				break;
+				bytes[0] = static_cast<char>(0xc0 | (c >> 6));
+				bytes[1] = static_cast<char>(0x80 | (c & 0x3f));
+				size = 2;
 			}
-			case StateCategory::DELETE_SELECTED_NEXT_FRAME:
+			else if (c < 0x10000)
 			{
-				states_.delete_selected_next_frame = 0;
-				break;
+				bytes[0] = static_cast<char>(0xe0 | (c >> 12));
+				bytes[1] = static_cast<char>(0x80 | ((c >> 6) & 0x3f));
+				bytes[2] = static_cast<char>(0x80 | (c & 0x3f));
+				size = 3;
 			}
-			case StateCategory::SETTING_WORKING_DIRECTORY:
+			else
+			{
+				bytes[0] = static_cast<char>(0xf0 | (c >> 18));
+				bytes[1] = static_cast<char>(0x80 | ((c >> 12) & 0x3f));
+				bytes[2] = static_cast<char>(0x80 | ((c >> 6) & 0x3f));
+				bytes[3] = static_cast<char>(0x80 | (c & 0x3f));
+				size = 4;
+			}
+
+			if (type_ahead_prefix_size_ + size > type_ahead_prefix_.size())
 			{
-				states_.setting_working_directory = 0;
 				break;
 			}
-			case StateCategory::CREATING_FILE:
+
+			std::ranges::copy_n(bytes.begin(), static_cast<std::ptrdiff_t>(size), type_ahead_prefix_.begin() + static_cast<std::ptrdiff_t>(type_ahead_prefix_size_));
+			type_ahead_prefix_size_ += size;
+		}
+
+		if (type_ahead_prefix_size_ == 0)
+		{
+			return;
+		}
+
+		// nothing starts with the prefix, keep the selection
+		const auto index = find_type_ahead_match();
+		if (index == file_descriptors_.size())
+		{
+			return;
+		}
+
+		// the match is scrolled into view even if it cannot be selected
+		file_descriptors_.select_none();
+		if (file_descriptors_.descriptors[index].is_directory == has_flag(FileBrowserFlags::SELECT_DIRECTORY))
+		{
+			file_descriptors_.select(index);
+		}
+
+		type_ahead_row_ = static_cast<int>(file_descriptors_view_rows_[index]);
+		append_state(StateCategory::REDRAW_REQUIRED);
+	}
+
+	auto FileBrowser::reselect_file_descriptors() noexcept -> void
+	{
+		// the entries may arrive in several batches, keep the ones not listed yet
+		const auto [first, last] = std::ranges::remove_if(
+			reselected_filenames_,
+			[this](const std::pair<std::string, bool>& filename) noexcept -> bool
+			{
+				const auto& [name, is_directory] = filename;
+
+				const auto index = find_file_descriptor(name, is_directory);
+				if (index == file_descriptors_.size())
+				{
+					return false;
+				}
+
+				// listed but hidden, a click could not select it either
+				if (is_directory or is_file_descriptor_matched(index))
+				{
+					file_descriptors_.select(index);
+				}
+				return true;
+			}
+		);
+
+		reselected_filenames_.erase(first, last);
+	}
+
+	auto FileBrowser::select_file_descriptors_view(const std::size_t first, const std::size_t last, const bool selected) noexcept -> void
+	{
+		if (not selected)
+		{
+			for (auto row = first; row <= last; ++row)
 			{
-				states_.creating_file = 0;
-				break;
+				file_descriptors_.deselect(file_descriptors_view_[row]);
 			}
-			case StateCategory::CREATING_DIRECTORY:
+
+			return;
+		}
+
+		const auto select_directory = has_flag(FileBrowserFlags::SELECT_DIRECTORY);
+
+		for (auto row = first; row <= last; ++row)
+		{
+			const auto index = file_descriptors_view_[row];
+
+			// drop parent folder path
+			if (index != 0 and file_descriptors_.descriptors[index].is_directory == select_directory)
 			{
-				states_.creating_directory = 0;
-				break;
+				file_descriptors_.select(index);
 			}
-			case StateCategory::CREATING:
+		}
+	}
+
+	auto FileBrowser::poll_directory_watcher() noexcept -> void
+	{
+		if (not directory_watcher_)
+		{
+			return;
+		}
+
+		std::vector<DirectoryWatcher::event_type> events{};
+		directory_watcher_->poll(events);
+
+		if (events.empty())
+		{
+			return;
+		}
+
+		append_state(StateCategory::REDRAW_REQUIRED);
+
+		const auto sort_order = get_sort_order();
+		// the listing is incomplete (still enumerating, or paused at the scan limit), the changes are applied right away anyway,
+		// the scanner may still report the changed names (or have enumerated them before the change), it must not override them
+		const auto scanning = directory_scanner_ != nullptr;
+
+		// the created entries are collected, sorted and merged in one pass (instead of being inserted one by one)
+		file_listing created{};
+		std::unordered_set<std::string_view> created_names{};
+
+		const auto merge_created = [&]() noexcept -> void
+		{
+			if (created.empty())
 			{
-				states_.creating_file = 0;
-				states_.creating_directory = 0;
-				break;
+				return;
 			}
-			case StateCategory::RENAMING_FILE:
+
+			DirectoryScanner::sort(created, 0);
+
+			const auto middle = file_descriptors_.size();
+			file_descriptors_.append(created);
+			merge_file_descriptors(middle);
+
+			created.clear();
+			created_names.clear();
+		};
+
+		for (const auto& [category, is_directory, name]: events)
+		{
+			if (scanning and category != DirectoryWatcher::EventCategory::RESCAN)
 			{
-				states_.renaming_file = 0;
-				break;
+				watched_names_.emplace(name);
 			}
-			case StateCategory::RENAMING_DIRECTORY:
+
+			switch (category)
 			{
-				states_.renaming_directory = 0;
-				break;
+				case DirectoryWatcher::EventCategory::CREATED:
+				{
+					// IN_ISDIR is not set for a symlink to a directory
+					std::error_code error_code{};
+					const auto status = IMFB_STATISTICS_CALL(StatisticsPhase::FILESYSTEM_STATUS, std::filesystem::status(working_directory_ / name, error_code));
+					if (error_code)
+					{
+						// already removed again, the IN_DELETE will follow
+						break;
+					}
+
+					const auto created_directory = is_directory or std::filesystem::is_directory(status);
+
+					// reported by the scanner already, or created twice in this batch (moved onto an existing name)
+					if (created_names.contains(name) or find_file_descriptor(name, created_directory) != file_descriptors_.size())
+					{
+						break;
+					}
+
+					created.push_back(name, created_directory, sort_order);
+					created_names.insert(name);
+					break;
+				}
+				case DirectoryWatcher::EventCategory::REMOVED:
+				{
+					// created in this batch, it must be in the listing before it can be removed
+					if (created_names.contains(name))
+					{
+						merge_created();
+					}
+
+					auto index = find_file_descriptor(name, is_directory);
+					if (index == file_descriptors_.size())
+					{
+						index = find_file_descriptor(name, not is_directory);
+					}
+
+					if (index != file_descriptors_.size())
+					{
+						file_descriptors_.erase(index);
+					}
+					break;
+				}
+				case DirectoryWatcher::EventCategory::RESCAN:
+				{
+					update_file_descriptors();
+					return;
+				}
 			}
-			case StateCategory::RENAMING:
+		}
+
+		merge_created();
+
+		bump_file_descriptors_revision();
+	}
+
+	auto FileBrowser::is_directory_watched() const noexcept -> bool
+	{
+		return directory_watcher_ and directory_watcher_->is_valid();
+	}
+
+	auto FileBrowser::refresh_file_descriptors() noexcept -> void
+	{
+		if (is_directory_watched())
+		{
+			return;
+		}
+
+		update_file_descriptors();
+	}
+
+	auto FileBrowser::is_listing_cached() const noexcept -> bool
+	{
+		return has_flag(FileBrowserFlags::CACHE_LISTING) or has_flag(FileBrowserFlags::PREFETCH_DIRECTORIES);
+	}
+
+	auto FileBrowser::cache_file_descriptors() noexcept -> void
+	{
+		if (listing_cache_key_.empty())
+		{
+			return;
+		}
+
+		ListingCache::instance().insert(listing_cache_key_, listing_cache_stamp_, get_sort_order(), file_descriptors_);
+	}
+
+	auto FileBrowser::prefetch_directory(const std::filesystem::path& directory) noexcept -> void
+	{
+		if (not directory_prefetcher_)
+		{
+			directory_prefetcher_ = std::make_shared<DirectoryPrefetcher>();
+		}
+
+		directory_prefetcher_->request(directory, get_sort_order());
+	}
+
+	auto FileBrowser::request_file_metadata() noexcept -> void
+	{
+		// at most this many invisible entries are requested per frame
+		constexpr std::size_t sweep_count_per_frame = 1024;
+
+		if (not has_flag(FileBrowserFlags::FETCH_METADATA))
+		{
+			stop_file_metadata_fetching();
+			return;
+		}
+
+		if (not metadata_fetcher_)
+		{
+			metadata_fetcher_ = std::make_shared<MetadataFetcher>();
+			metadata_fetcher_->set_generation(file_descriptors_generation_);
+			metadata_fetcher_->start();
+		}
+
+		std::vector<MetadataFetcher::request_type> requests{};
+
+		const auto make_request = [&](const std::size_t index) noexcept -> void
+		{
+			auto& descriptor = file_descriptors_.descriptors[index];
+			descriptor.metadata_state = MetadataState::PENDING;
+
+			const auto name = file_descriptors_.name(index);
+			requests.emplace_back(file_descriptors_generation_, index, descriptor.is_directory, std::string{name}, working_directory_ / name);
+		};
+
+		for (const auto index: metadata_visible_requests_)
+		{
+			if (file_descriptors_.descriptors[index].metadata_state == MetadataState::NONE)
 			{
-				states_.renaming_file = 0;
-				states_.renaming_directory = 0;
-				break;
+				make_request(index);
 			}
-			default:
+		}
+		metadata_visible_requests_.clear();
+
+		metadata_fetcher_->submit(requests, true);
+
+		// the listing is still changing (every merge restarts the sweep)
+		if (has_state(StateCategory::SCANNING))
+		{
+			return;
+		}
+
+		for (; metadata_sweep_cursor_ < file_descriptors_.size() and requests.size() < sweep_count_per_frame; ++metadata_sweep_cursor_)
+		{
+			if (file_descriptors_.descriptors[metadata_sweep_cursor_].metadata_state == MetadataState::NONE)
 			{
-				std::unreachable();
+				make_request(metadata_sweep_cursor_);
 			}
 		}
-#else
-		assert(state != StateCategory::NONE);
 
-		states_ = static_cast<StateCategory>(std::to_underlying(states_) & ~std::to_underlying(state));
-#endif
+		metadata_fetcher_->submit(requests, false);
 	}
 
-	auto FileBrowser::is_state_editing() const noexcept -> bool
+	auto FileBrowser::poll_file_metadata() noexcept -> void
 	{
-		return
-				has_state(StateCategory::SETTING_WORKING_DIRECTORY) or
-				has_state(StateCategory::CREATING) or
-				has_state(StateCategory::RENAMING);
-	}
+		if (not metadata_fetcher_)
+		{
+			return;
+		}
 
-	auto FileBrowser::is_filter_matched(const std::filesystem::path& extension) const noexcept -> bool
-	{
-		if (filters_.empty())
+		std::vector<MetadataFetcher::result_type> results{};
+		metadata_fetcher_->poll(results);
+
+		if (not results.empty())
 		{
-			return true;
+			append_state(StateCategory::REDRAW_REQUIRED);
 		}
 
-		if (selected_filter_ == 0)
+		for (const auto& result: results)
 		{
-			if (has_combined_filter())
+			// requested for a previous working directory (or before a rescan)
+			if (result.generation != file_descriptors_generation_)
 			{
-				return std::ranges::any_of(
-					// drop the combined filter
-					filters_ | std::views::drop(1),
-					[es = extension.string()](const std::string& filter) noexcept -> bool
+				continue;
+			}
+
+			// the merges / watcher updates since the request may have moved the entry, find it again by name
+			auto index = result.index;
+			if (
+				index >= file_descriptors_.size() or
+				file_descriptors_.descriptors[index].is_directory != result.is_directory or
+				file_descriptors_.name(index) != result.name
+			)
+			{
+				index = find_file_descriptor(result.name, result.is_directory);
+
+				// removed meanwhile
+				if (index == file_descriptors_.size())
+				{
+					continue;
+				}
+			}
+
+			file_descriptors_.descriptors[index].metadata_state = result.state;
+			file_descriptors_.metadata[index] = result.metadata;
+			file_metadata_revision_ += 1;
+		}
+
+		const auto now = std::chrono::steady_clock::now();
+
+		// the metadata streams in, keep the order up to date
+		// re-sorting a large listing for every batch would stall the scrolling, so the batches are applied after several times the cost of a sort
+		if (
+			not results.empty() and
+			metadata_order_deadline_ == std::chrono::steady_clock::time_point{} and
+			std::ranges::any_of(
+				sort_specs_,
+				[](const sort_spec& spec) noexcept -> bool
+				{
+					return spec.column == SortColumn::SIZE or spec.column == SortColumn::LAST_WRITE_TIME;
+				}
+			)
+		)
+		{
+			metadata_order_deadline_ = now + 16 * file_descriptors_order_cost_;
+		}
+
+		if (metadata_order_deadline_ != std::chrono::steady_clock::time_point{} and now >= metadata_order_deadline_)
+		{
+			metadata_order_deadline_ = {};
+			append_state(StateCategory::SORT_DIRTY);
+			append_state(StateCategory::REDRAW_REQUIRED);
+		}
+	}
+
+	auto FileBrowser::stop_file_metadata_fetching() noexcept -> void
+	{
+		if (metadata_fetcher_)
+		{
+			metadata_fetcher_->stop();
+			metadata_fetcher_.reset();
+
+			std::ranges::for_each(
+				file_descriptors_.descriptors,
+				[](file_descriptor& descriptor) noexcept -> void
+				{
+					if (descriptor.metadata_state == MetadataState::PENDING)
 					{
-						return filter == es;
+						descriptor.metadata_state = MetadataState::NONE;
 					}
-				);
-			}
+				}
+			);
+		}
+	}
 
-			// wildcard
-			return true;
+#if IMFB_STATISTICS
+	auto FileBrowser::statistics_type::average() const noexcept -> std::chrono::nanoseconds
+	{
+		if (count == 0)
+		{
+			return std::chrono::nanoseconds{0};
 		}
 
-		const auto& filter = filters_[selected_filter_];
-		return filter == extension;
+		return total / count;
 	}
 
-	auto FileBrowser::has_combined_filter() const noexcept -> bool
+	auto FileBrowser::record_statistics(const StatisticsPhase phase, const std::chrono::nanoseconds elapsed) noexcept -> void
 	{
-		assert(not filters_.empty());
+		auto& statistics = statistics_[std::to_underlying(phase)];
 
-		return filters_.front() != wildcard_filter;
+		statistics.last = elapsed;
+		statistics.total += elapsed;
+		statistics.max = std::ranges::max(statistics.max, elapsed);
+		statistics.count += 1;
 	}
+#endif
 
-	auto FileBrowser::update_file_descriptors() noexcept -> void
+	auto FileBrowser::reset_thumbnails() noexcept -> void
 	{
-		file_descriptors_.clear();
+		append_state(StateCategory::REDRAW_REQUIRED);
 
-		// parent folder
-		file_descriptors_.push_back({.name = "..", .extension = "", .display_name = std::string{parent_path_name}, .is_directory = true});
+		// the workers of the previous loader finish on their own, their results are discarded
+		thumbnail_loader_.reset();
+		thumbnail_requests_.clear();
+		if (thumbnail_cache_)
+		{
+			thumbnail_cache_->clear();
+		}
 
-		std::error_code error_code{};
-		auto directory_iterator = std::filesystem::directory_iterator{working_directory_, error_code};
+		if (thumbnail_provider_)
+		{
+			thumbnail_loader_ = std::make_shared<ThumbnailLoader>(thumbnail_provider_, thumbnail_size_);
+		}
+	}
 
-		if (error_code)
+	auto FileBrowser::drop_thumbnail_requests() noexcept -> void
+	{
+		if (thumbnail_loader_)
+		{
+			thumbnail_loader_->drop();
+		}
+	}
+
+	auto FileBrowser::poll_thumbnails() noexcept -> void
+	{
+		if (not thumbnail_loader_)
 		{
-			tooltip_ = std::format(
-				"Error occurred while iterate\n\t{}\n\t{}",
-				working_directory_.string(),
-				error_code.message()
-			);
 			return;
 		}
 
-		std::string tooltip{"Error occurred\n"};
+		std::vector<ThumbnailLoader::result_type> results{};
+		thumbnail_loader_->poll(results);
+
+		for (const auto& result: results)
+		{
+			auto* entry = thumbnail_cache_->find_pending(result.key);
+			if (entry == nullptr)
+			{
+				continue;
+			}
+
+			if (result.state == ThumbnailState::READY)
+			{
+				// the pixels are released with the results, only the texture is kept
+				if (const auto texture = thumbnail_upload_(result.image);
+					texture != thumbnail_texture_type{0})
+				{
+					thumbnail_cache_->resolve(*entry, ThumbnailState::READY, texture, result.image.width, result.image.height);
+				}
+				else
+				{
+					thumbnail_cache_->resolve(*entry, ThumbnailState::UNAVAILABLE, thumbnail_texture_type{0}, 0, 0);
+				}
+			}
+			else
+			{
+				thumbnail_cache_->resolve(*entry, result.state, thumbnail_texture_type{0}, 0, 0);
+			}
+		}
+
+		if (not results.empty())
+		{
+			thumbnail_cache_->evict();
+			append_state(StateCategory::REDRAW_REQUIRED);
+		}
+	}
+
+	auto FileBrowser::update_redraw_state() noexcept -> void
+	{
+		// consumed by the next frame
+		if (
+			has_state(StateCategory::SET_WORKING_DIRECTORY_NEXT_FRAME) or
+			has_state(StateCategory::DELETE_SELECTED_NEXT_FRAME) or
+			has_state(StateCategory::FOCUSING_EDITOR_NEXT_FRAME) or
+			has_state(StateCategory::SORT_DIRTY) or
+			has_state(StateCategory::VIEW_DIRTY) or
+			// the popup is closed by the next frame
+			has_state(StateCategory::SELECTED)
+		)
+		{
+			append_state(StateCategory::REDRAW_REQUIRED);
+		}
+
+		// the caret of the editors blinks, an item is dragged (scrollbar / box selection)
+		if (is_state_editing() or (ImGui::IsWindowFocused(ImGuiFocusedFlags_RootAndChildWindows) and ImGui::IsAnyItemActive()))
+		{
+			append_state(StateCategory::REDRAW_REQUIRED);
+		}
+
+		// the hovered item is highlighted right away, but its tooltip only shows up once the mouse stayed still for a while
+		if (const auto& io = ImGui::GetIO();
+			(io.MouseDelta.x != 0 or io.MouseDelta.y != 0) and ImGui::IsWindowHovered(ImGuiHoveredFlags_RootAndChildWindows))
+		{
+			const auto& style = ImGui::GetStyle();
+			const std::chrono::duration<float> hover_delay{style.HoverStationaryDelay + style.HoverDelayNormal};
+
+			redraw_deadline_ = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(hover_delay);
+		}
+	}
+
+	auto FileBrowser::update_breadcrumb() noexcept -> void
+	{
+		breadcrumb_.path.clear();
+		breadcrumb_.labels.clear();
+		breadcrumb_.segments.clear();
+		// measured on the next frame
+		breadcrumb_.font = nullptr;
+		breadcrumb_.layout_width = -1;
+		breadcrumb_.first_visible = 1;
+
+		// the path is only walked here, each segment remembers the length of the path that leads to it
+		std::filesystem::path combined_working_directory{};
+
+		for (const auto [index, sub]: std::views::enumerate(working_directory_))
+		{
+#ifdef _WIN32
+			// skip '\'
+			// e.g. 'C:' '\' 'workspace'
+			if (index == 1)
+			{
+				assert(sub == "\\");
+				continue;
+			}
+#endif
+
+			combined_working_directory /= sub;
 
-		std::ranges::for_each(
-			directory_iterator,
-			[&](const std::filesystem::directory_entry& entry) noexcept -> void
+#ifdef _WIN32
+			if (index == 0)
 			{
-				file_descriptor descriptor{};
+				// add '\'
+				combined_working_directory /= "\\";
+			}
+#endif
 
-				if (entry.is_regular_file(error_code))
-				{
-					descriptor.is_directory = false;
-				}
-				else if (entry.is_directory(error_code))
-				{
-					descriptor.is_directory = true;
-				}
+			auto label = sub.string();
+			// "/home/user/" ==> '/' 'home' 'user' ''
+			if (label.empty())
+			{
+				continue;
+			}
 
-				if (error_code)
-				{
-					descriptor.name = "???";
-					descriptor.extension = ".?";
+			breadcrumb_.path = combined_working_directory.string();
 
-					descriptor.display_name = error_code.message();
+			breadcrumb_.segments.push_back({
+					.label_offset = static_cast<std::uint32_t>(breadcrumb_.labels.size()),
+					.prefix_size = static_cast<std::uint32_t>(breadcrumb_.path.size()),
+					.text_width = 0
+			});
+			breadcrumb_.labels.append(label);
+			breadcrumb_.labels.push_back('\0');
+		}
 
-					std::format_to(
-						std::back_inserter(tooltip),
-						"\t{}\n\t\t{}\n",
-						entry.path().string(),
-						error_code.message()
-					);
-				}
-				else
-				{
-					const auto& entry_path = entry.path();
+		// the requests of the previous directory are not visible anymore
+		thumbnail_directory_ = (working_directory_ / "").string();
+		drop_thumbnail_requests();
+	}
 
-					descriptor.name = entry_path.filename();
-					descriptor.extension = entry_path.extension();
+	auto FileBrowser::layout_breadcrumb() noexcept -> void
+	{
+		const auto& style = ImGui::GetStyle();
 
-					if (descriptor.is_directory)
-					{
-						descriptor.display_name = std::format("[DIR] {}", descriptor.name.string());
-					}
-					else
-					{
-						descriptor.display_name = descriptor.name.string();
-					}
-				}
+		if (const auto* font = ImGui::GetFont();
+			breadcrumb_.font != font or breadcrumb_.font_size != ImGui::GetFontSize())
+		{
+			breadcrumb_.font = font;
+			breadcrumb_.font_size = ImGui::GetFontSize();
 
-				file_descriptors_.push_back(std::move(descriptor));
+			for (auto& segment: breadcrumb_.segments)
+			{
+				segment.text_width = ImGui::CalcTextSize(breadcrumb_.labels.data() + segment.label_offset).x;
 			}
-		);
 
-		if (error_code)
-		{
-			tooltip_ = std::move(tooltip);
+			breadcrumb_.trailing_text_width = ImGui::CalcTextSize("#").x + ImGui::CalcTextSize("*").x;
+			breadcrumb_.overflow_text_width = ImGui::CalcTextSize("...").x;
+
+			breadcrumb_.layout_width = -1;
 		}
 
-		if (file_descriptors_.size() > 2)
+		const auto available_width = ImGui::GetContentRegionAvail().x;
+		if (breadcrumb_.layout_width == available_width)
 		{
-			std::ranges::sort(
-				// drop parent folder path
-				file_descriptors_ | std::views::drop(1),
-				[](const file_descriptor& lhs, const file_descriptor& rhs) noexcept -> bool
-				{
-					if (lhs.is_directory != rhs.is_directory)
-					{
-						return lhs.is_directory;
-					}
-
-					const auto to_lower_name = [](std::string& name) noexcept -> void
-					{
-						const auto to_lower = [](const char c) noexcept -> char
-						{
-							return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
-						};
+			return;
+		}
+		breadcrumb_.layout_width = available_width;
 
-						std::ranges::transform(name, name.begin(), to_lower);
-					};
+		const auto button_width = [&](const float text_width) noexcept -> float
+		{
+			return text_width + style.FramePadding.x * 2 + style.ItemSpacing.x;
+		};
 
-					auto lhs_name = lhs.name.string();
-					auto rhs_name = rhs.name.string();
+		// the trailing buttons always stay visible
+		auto width = button_width(0) * 2 + breadcrumb_.trailing_text_width;
+		for (const auto& segment: breadcrumb_.segments)
+		{
+			width += button_width(segment.text_width);
+		}
 
-					to_lower_name(lhs_name);
-					to_lower_name(rhs_name);
+		breadcrumb_.first_visible = 1;
+		if (width <= available_width)
+		{
+			return;
+		}
 
-					return lhs_name < rhs_name;
-				}
-			);
+		// collapse from the root, the first segment (root) and the last segment (working directory) stay visible
+		width += button_width(breadcrumb_.overflow_text_width);
+		while (breadcrumb_.first_visible + 1 < breadcrumb_.segments.size() and width > available_width)
+		{
+			width -= button_width(breadcrumb_.segments[breadcrumb_.first_visible].text_width);
+			breadcrumb_.first_visible += 1;
 		}
 	}
 
 	auto FileBrowser::show_working_path() noexcept -> void
 	{
+		IMFB_STATISTICS_SCOPE(StatisticsPhase::SHOW_WORKING_PATH);
+
 		if (has_state(StateCategory::SETTING_WORKING_DIRECTORY))
 		{
 			if (has_state(StateCategory::FOCUSING_EDITOR_NEXT_FRAME))
@@ -621,10 +4987,9 @@ namespace ImGui
 					}
 
 					std::filesystem::path path{view};
-					if (is_directory(path, error_code))
+					if (IMFB_STATISTICS_CALL(StatisticsPhase::FILESYSTEM_STATUS, is_directory(path, error_code)))
 					{
-						working_directory_ = std::move(path);
-						append_state(StateCategory::SET_WORKING_DIRECTORY_NEXT_FRAME);
+						change_working_directory(std::move(path));
 						break;
 					}
 
@@ -635,10 +5000,9 @@ namespace ImGui
 					}
 
 					auto parent_path = path.parent_path();
-					if (is_directory(parent_path, error_code))
+					if (IMFB_STATISTICS_CALL(StatisticsPhase::FILESYSTEM_STATUS, is_directory(parent_path, error_code)))
 					{
-						working_directory_ = std::move(parent_path);
-						append_state(StateCategory::SET_WORKING_DIRECTORY_NEXT_FRAME);
+						change_working_directory(std::move(parent_path));
 						break;
 					}
 
@@ -654,49 +5018,55 @@ namespace ImGui
 		}
 		else
 		{
-			std::filesystem::path combined_working_directory{};
-			bool pressed = false;
+			layout_breadcrumb();
 
-			for (const auto [index, sub]: std::views::enumerate(working_directory_))
+			const auto segments_size = breadcrumb_.segments.size();
+			// the path is only built if a button is pressed
+			auto pressed_index = segments_size;
+
+			for (std::size_t index = 0; index < segments_size; ++index)
 			{
-				if (not pressed)
+				if (index == 1 and breadcrumb_.first_visible != 1)
 				{
-					combined_working_directory /= sub;
-
-#ifdef _WIN32
-					if (index == 0)
+					ImGui::SameLine();
+					if (ImGui::SmallButton("..."))
 					{
-						// add '\'
-						combined_working_directory /= "\\";
+						ImGui::OpenPopup("##breadcrumb_overflow");
 					}
-#endif
-				}
 
-#ifdef _WIN32
+					if (ImGui::BeginPopup("##breadcrumb_overflow"))
+					{
+						for (std::size_t collapsed = 1; collapsed < breadcrumb_.first_visible; ++collapsed)
+						{
+							ImGui::PushID(static_cast<int>(collapsed));
+							if (ImGui::Selectable(breadcrumb_.label(collapsed)) and pressed_index == segments_size)
+							{
+								pressed_index = collapsed;
+							}
+							ImGui::PopID();
+						}
 
-				// skip '\'
-				// e.g. 'C:' '\' 'workspace'
-				if (index == 1)
-				{
-					assert(sub == "\\");
-					continue;
+						ImGui::EndPopup();
+					}
+
+					index = breadcrumb_.first_visible;
 				}
-#endif
 
 				ImGui::PushID(static_cast<int>(index));
 				if (index > 0)
 				{
 					ImGui::SameLine();
 				}
-				const auto label = sub.string();
-				pressed |= ImGui::SmallButton(label.c_str());
+				if (ImGui::SmallButton(breadcrumb_.label(index)) and pressed_index == segments_size)
+				{
+					pressed_index = index;
+				}
 				ImGui::PopID();
 			}
 
-			if (pressed)
+			if (pressed_index != segments_size)
 			{
-				working_directory_ = combined_working_directory;
-				append_state(StateCategory::SET_WORKING_DIRECTORY_NEXT_FRAME);
+				change_working_directory(std::filesystem::path{breadcrumb_.prefix(pressed_index)});
 			}
 
 			if (has_flag(FileBrowserFlags::ALLOW_SET_WORKING_DIRECTORY))
@@ -749,6 +5119,180 @@ namespace ImGui
 		}
 	}
 
+	auto FileBrowser::setup_files_table() noexcept -> void
+	{
+		const auto table_view = is_table_view();
+
+		if (table_view)
+		{
+			// keep the header visible
+			ImGui::TableSetupScrollFreeze(0, 1);
+		}
+
+		// sorting by metadata requires FileBrowserFlags::FETCH_METADATA
+		const auto metadata_sort_flags = has_flag(FileBrowserFlags::FETCH_METADATA) ? ImGuiTableColumnFlags_None : ImGuiTableColumnFlags_NoSort;
+
+		ImGui::TableSetupColumn("Name", ImGuiTableColumnFlags_DefaultSort | ImGuiTableColumnFlags_WidthStretch, 0, std::to_underlying(SortColumn::NAME));
+		ImGui::TableSetupColumn("Extension", ImGuiTableColumnFlags_WidthStretch, 0, std::to_underlying(SortColumn::EXTENSION));
+		ImGui::TableSetupColumn("Size", metadata_sort_flags | ImGuiTableColumnFlags_WidthStretch, 0, std::to_underlying(SortColumn::SIZE));
+		ImGui::TableSetupColumn("Modified", metadata_sort_flags | ImGuiTableColumnFlags_WidthStretch, 0, std::to_underlying(SortColumn::LAST_WRITE_TIME));
+		ImGui::TableSetupColumn("Type", ImGuiTableColumnFlags_WidthStretch, 0, std::to_underlying(SortColumn::TYPE));
+		if (table_view)
+		{
+			ImGui::TableSetupColumn("Permissions", ImGuiTableColumnFlags_NoSort | ImGuiTableColumnFlags_WidthStretch);
+		}
+		ImGui::TableHeadersRow();
+
+		if (auto* specs = ImGui::TableGetSortSpecs();
+			specs != nullptr and specs->SpecsDirty)
+		{
+			specs->SpecsDirty = false;
+
+			sort_specs_.clear();
+			for (const auto& spec: std::span{specs->Specs, static_cast<std::size_t>(specs->SpecsCount)})
+			{
+				sort_specs_.push_back(
+					{
+							.column = static_cast<SortColumn>(spec.ColumnUserID),
+							.descending = spec.SortDirection == ImGuiSortDirection_Descending
+					}
+				);
+			}
+
+			append_state(StateCategory::SORT_DIRTY);
+		}
+	}
+
+	auto FileBrowser::show_files_sort_header() noexcept -> void
+	{
+		if (not ImGui::BeginTable(
+			"files_sort_header",
+			5,
+			ImGuiTableFlags_Sortable |
+			ImGuiTableFlags_SortMulti |
+			ImGuiTableFlags_BordersInnerV
+		))
+		{
+			return;
+		}
+		ScopeGuard table_guard
+		{
+				[]
+				{
+					ImGui::EndTable();
+				}
+		};
+
+		setup_files_table();
+	}
+
+	auto FileBrowser::is_table_view() const noexcept -> bool
+	{
+		return has_flag(FileBrowserFlags::TABLE_VIEW) and not has_flag(FileBrowserFlags::GRID_VIEW);
+	}
+
+	auto FileBrowser::show_file_descriptor_columns(const std::size_t index) const noexcept -> void
+	{
+		const auto& descriptor = file_descriptors_.descriptors[index];
+		const auto& metadata = file_descriptors_.metadata[index];
+		const auto metadata_ready = descriptor.metadata_state == MetadataState::READY;
+
+		// extension
+		ImGui::TableNextColumn();
+		const auto extension = file_descriptors_.extension(index);
+		ImGui::TextUnformatted(extension.data(), extension.data() + extension.size());
+
+		// size (the size of a directory is meaningless)
+		ImGui::TableNextColumn();
+		if (metadata_ready and not descriptor.is_directory)
+		{
+			const auto size = format_file_size(metadata.size);
+			ImGui::TextUnformatted(size.c_str());
+		}
+
+		// modified
+		ImGui::TableNextColumn();
+		if (metadata_ready)
+		{
+			const auto last_write_time = format_last_write_time(metadata.last_write_time);
+			ImGui::TextUnformatted(last_write_time.data());
+		}
+
+		// type
+		ImGui::TableNextColumn();
+		ImGui::TextUnformatted(descriptor.is_directory ? "Directory" : "File");
+
+		// permissions
+		ImGui::TableNextColumn();
+		if (metadata_ready)
+		{
+			const auto permissions = format_permissions(metadata.permissions);
+			ImGui::TextUnformatted(permissions.c_str());
+		}
+	}
+
+	auto FileBrowser::show_file_descriptor_thumbnail(const std::size_t index) noexcept -> void
+	{
+		static_assert(sizeof(ImTextureID) <= sizeof(thumbnail_texture_type));
+
+		const auto& descriptor = file_descriptors_.descriptors[index];
+		const auto name = file_descriptors_.name(index);
+
+		const auto min = ImGui::GetItemRectMin();
+		const auto max = ImGui::GetItemRectMax();
+		const auto size = static_cast<float>(thumbnail_size_);
+
+		auto* draw_list = ImGui::GetWindowDrawList();
+
+		const ThumbnailCache::entry_type* thumbnail = nullptr;
+		if (thumbnail_cache_ and not descriptor.is_directory)
+		{
+			thumbnail_key_.assign(thumbnail_directory_);
+			thumbnail_key_.append(name);
+
+			thumbnail = thumbnail_cache_->find(thumbnail_key_);
+			if (thumbnail == nullptr)
+			{
+				thumbnail_cache_->insert(thumbnail_key_);
+				thumbnail_requests_.emplace_back(thumbnail_key_, working_directory_ / name);
+			}
+		}
+
+		if (thumbnail != nullptr and thumbnail->state == ThumbnailState::READY)
+		{
+			ImTextureID texture_id{};
+			std::memcpy(&texture_id, &thumbnail->texture, sizeof(ImTextureID));
+
+			// keep the aspect ratio, centered in the cell
+			const auto scale = std::ranges::min(size / static_cast<float>(thumbnail->width), size / static_cast<float>(thumbnail->height));
+			const ImVec2 image_size{static_cast<float>(thumbnail->width) * scale, static_cast<float>(thumbnail->height) * scale};
+			const ImVec2 image_min{min.x + (size - image_size.x) / 2, min.y + (size - image_size.y) / 2};
+
+			draw_list->AddImage(texture_id, image_min, {image_min.x + image_size.x, image_min.y + image_size.y});
+		}
+		else
+		{
+			// placeholder, the extension tells the files apart while decoding (or if they are not images)
+			const auto extension = file_descriptors_.extension(index);
+			const std::string_view placeholder = descriptor.is_directory ? "[DIR]" : (extension.empty() ? "[FILE]" : extension);
+
+			const auto placeholder_size = ImGui::CalcTextSize(placeholder.data(), placeholder.data() + placeholder.size());
+			ImGui::PushClipRect(min, max, true);
+			draw_list->AddText(
+				{min.x + std::ranges::max(0.f, (size - placeholder_size.x) / 2), min.y + (size - placeholder_size.y) / 2},
+				ImGui::GetColorU32(ImGuiCol_TextDisabled),
+				placeholder.data(),
+				placeholder.data() + placeholder.size()
+			);
+			ImGui::PopClipRect();
+		}
+
+		// the name below the thumbnail, clipped to the cell
+		ImGui::PushClipRect(min, max, true);
+		draw_list->AddText({min.x, min.y + size}, ImGui::GetColorU32(ImGuiCol_Text), name.data(), name.data() + name.size());
+		ImGui::PopClipRect();
+	}
+
 	auto FileBrowser::show_files_window_context() noexcept -> void
 	{
 		if (has_flag(FileBrowserFlags::ALLOW_CREATE))
@@ -785,155 +5329,309 @@ namespace ImGui
 			}
 		}
 
-		const auto select_directory = has_flag(FileBrowserFlags::SELECT_DIRECTORY);
-		const auto hide_regular_files = select_directory and has_flag(FileBrowserFlags::HIDE_REGULAR_FILES);
+		const auto fetch_metadata = has_flag(FileBrowserFlags::FETCH_METADATA);
+		const auto prefetch_directories = has_flag(FileBrowserFlags::PREFETCH_DIRECTORIES);
+		const auto table_view = is_table_view();
+		const auto grid_view = has_flag(FileBrowserFlags::GRID_VIEW);
+
+		update_type_ahead();
 
-		for (const auto& descriptor: file_descriptors_)
+		// the selection user data of a row is its position in file_descriptors_view_, so a range request is a run of rows
+		const auto apply_selection_requests = [this](const ImGuiMultiSelectIO& multi_select_io) noexcept -> void
 		{
-			if (not descriptor.is_directory)
+			for (const auto& request: multi_select_io.Requests)
 			{
-				if (hide_regular_files)
+				if (request.Type == ImGuiSelectionRequestType_SetAll)
 				{
-					continue;
+					if (not request.Selected)
+					{
+						file_descriptors_.select_none();
+					}
+					else if (not file_descriptors_view_.empty())
+					{
+						// the filtered out entries are not in the view
+						select_file_descriptors_view(0, file_descriptors_view_.size() - 1, true);
+					}
 				}
-
-				if (not is_filter_matched(descriptor.extension))
+				else if (request.Type == ImGuiSelectionRequestType_SetRange)
 				{
-					continue;
+					select_file_descriptors_view(static_cast<std::size_t>(request.RangeFirstItem), static_cast<std::size_t>(request.RangeLastItem), request.Selected);
 				}
 			}
+		};
+
+		const auto multi_select_flags =
+				ImGuiMultiSelectFlags_ClearOnEscape |
+				ImGuiMultiSelectFlags_ClearOnClickVoid |
+				(
+					has_flag(FileBrowserFlags::MULTIPLE_SELECTION)
+						? (grid_view ? ImGuiMultiSelectFlags_BoxSelect2d : ImGuiMultiSelectFlags_BoxSelect1d)
+						: ImGuiMultiSelectFlags_SingleSelect
+				);
+
+		const auto* multi_select_io = ImGui::BeginMultiSelect(
+			multi_select_flags,
+			static_cast<int>(file_descriptors_.selected_count()),
+			static_cast<int>(file_descriptors_view_.size())
+		);
+		apply_selection_requests(*multi_select_io);
+
+		const auto rows = static_cast<int>(file_descriptors_view_.size());
+
+		// FileBrowserFlags::GRID_VIEW, a line of the clipper holds several cells
+		auto columns = 1;
+		ImVec2 cell_size{0, 0};
+		ImGuiListClipper clipper{};
+		if (grid_view)
+		{
+			const auto& style = ImGui::GetStyle();
+			const auto size = static_cast<float>(thumbnail_size_);
+
+			// the name below the thumbnail
+			cell_size = {size, size + ImGui::GetTextLineHeight()};
+			columns = std::ranges::max(1, static_cast<int>((ImGui::GetContentRegionAvail().x + style.ItemSpacing.x) / (cell_size.x + style.ItemSpacing.x)));
+
+			const auto line_height = cell_size.y + style.ItemSpacing.y;
+			clipper.Begin((rows + columns - 1) / columns, line_height);
+
+			// the queued requests belong to the cells which were visible, the decoding follows the scrolling
+			if (const auto first_line = static_cast<std::size_t>(ImGui::GetScrollY() / line_height);
+				first_line != thumbnail_first_line_)
+			{
+				thumbnail_first_line_ = first_line;
+				drop_thumbnail_requests();
+			}
+		}
+		else
+		{
+			clipper.Begin(rows);
+		}
+
+		// the range source must be submitted even if it is scrolled out of view
+		if (multi_select_io->RangeSrcItem != -1)
+		{
+			clipper.IncludeItemByIndex(static_cast<int>(multi_select_io->RangeSrcItem) / columns);
+		}
+		if (type_ahead_row_ != -1)
+		{
+			clipper.IncludeItemByIndex(type_ahead_row_ / columns);
+		}
 
-			if (const auto selected = selected_filenames_.contains(descriptor.name);
-				ImGui::Selectable(descriptor.display_name.c_str(), selected, ImGuiSelectableFlags_NoAutoClosePopups))
+		while (clipper.Step())
+		{
+			for (auto row = clipper.DisplayStart * columns; row < std::ranges::min(clipper.DisplayEnd * columns, rows); ++row)
 			{
-				const auto selectable = descriptor.name != ".." and descriptor.is_directory == has_flag(FileBrowserFlags::SELECT_DIRECTORY);
-				const auto multiple_select =
-						has_flag(FileBrowserFlags::MULTIPLE_SELECTION) and
-						ImGui::GetIO().KeyCtrl and
-						ImGui::IsWindowFocused(ImGuiFocusedFlags_RootAndChildWindows);
+				const auto index = file_descriptors_view_[static_cast<std::size_t>(row)];
+				const auto& descriptor = file_descriptors_.descriptors[index];
+
+				const auto name = file_descriptors_.name(index);
+
+				if (table_view)
+				{
+					ImGui::TableNextRow();
+					ImGui::TableNextColumn();
+				}
 
-				if (selected)
+				// the nav cursor follows the match, so does the range source of the multi-select (a Shift+click / Shift+arrow extends from the match)
+				if (row == type_ahead_row_)
 				{
-					if (multiple_select)
+					ImGui::SetKeyboardFocusHere();
+					ImGui::SetNavCursorVisible(true);
+				}
+
+				ImGui::SetNextItemSelectionUserData(row);
+				if (grid_view)
+				{
+					if (row % columns != 0)
 					{
-						selected_filenames_.erase(descriptor.name);
+						ImGui::SameLine();
 					}
-					else
+
+					// the label is drawn by show_file_descriptor_thumbnail
+					ImGui::PushID(static_cast<int>(index));
+					ImGui::Selectable("##cell", file_descriptors_.is_selected(index), ImGuiSelectableFlags_NoAutoClosePopups, cell_size);
+					ImGui::PopID();
+
+					show_file_descriptor_thumbnail(index);
+				}
+				else
+				{
+					ImGui::Selectable(
+						file_descriptors_.display_name(index),
+						file_descriptors_.is_selected(index),
+						ImGuiSelectableFlags_NoAutoClosePopups | (table_view ? ImGuiSelectableFlags_SpanAllColumns : ImGuiSelectableFlags_None)
+					);
+				}
+
+				if (row == type_ahead_row_)
+				{
+					type_ahead_row_ = -1;
+
+					if (not ImGui::IsItemVisible())
 					{
-						selected_filenames_ = {descriptor.name};
+						ImGui::SetScrollHereY(.5f);
 					}
 				}
-				else if (selectable)
+
+				if (prefetch_directories and descriptor.is_directory and index != 0 and index != prefetch_hovered_index_ and ImGui::IsItemHovered())
+				{
+					prefetch_hovered_index_ = index;
+					prefetch_directory(working_directory_ / name);
+				}
+
+				if (fetch_metadata)
 				{
-					if (multiple_select)
+					if (descriptor.metadata_state == MetadataState::NONE and ImGui::IsItemVisible())
 					{
-						selected_filenames_.insert(descriptor.name);
+						metadata_visible_requests_.push_back(index);
 					}
-					else
+					// the table shows the metadata already
+					else if (not table_view and descriptor.metadata_state == MetadataState::READY and ImGui::BeginItemTooltip())
 					{
-						selected_filenames_ = {descriptor.name};
+						const auto& metadata = file_descriptors_.metadata[index];
+
+						if (not descriptor.is_directory)
+						{
+							const auto size = format_file_size(metadata.size);
+							ImGui::Text("Size: %s", size.c_str());
+						}
+						const auto last_write_time = format_last_write_time(metadata.last_write_time);
+						ImGui::Text("Modified: %s", last_write_time.data());
+						const auto permissions = format_permissions(metadata.permissions);
+						ImGui::Text("Permissions: %s", permissions.c_str());
+
+						ImGui::EndTooltip();
 					}
 				}
-			}
 
-			if (has_flag(FileBrowserFlags::ALLOW_RENAME) or has_flag(FileBrowserFlags::ALLOW_DELETE))
-			{
-				if (ImGui::BeginPopupContextItem(descriptor.name.string().c_str(), ImGuiPopupFlags_MouseButtonRight))
+				if (has_flag(FileBrowserFlags::ALLOW_RENAME) or has_flag(FileBrowserFlags::ALLOW_DELETE))
 				{
-					if (
-						(has_flag(FileBrowserFlags::ALLOW_RENAME_FILE) == (not descriptor.is_directory)) or
-						(has_flag(FileBrowserFlags::ALLOW_RENAME_DIRECTORY) == descriptor.is_directory)
-					)
+					// null-terminated
+					if (ImGui::BeginPopupContextItem(name.data(), ImGuiPopupFlags_MouseButtonRight))
 					{
-						if (ImGui::MenuItem("Rename"))
+						if (
+							(has_flag(FileBrowserFlags::ALLOW_RENAME_FILE) == (not descriptor.is_directory)) or
+							(has_flag(FileBrowserFlags::ALLOW_RENAME_DIRECTORY) == descriptor.is_directory)
+						)
 						{
-							selected_filenames_ = {descriptor.name};
-
-							const auto filename_string = descriptor.name.string();
-
-							edit_rename_file_or_directory_buffer_.capacity = filename_string.size() + 1;
-							edit_rename_file_or_directory_buffer_.data = std::make_unique_for_overwrite<char[]>(edit_rename_file_or_directory_buffer_.capacity);
-							edit_rename_file_or_directory_buffer_.data[filename_string.size()] = '\0';
-
-							std::ranges::copy(filename_string, edit_rename_file_or_directory_buffer_.data.get());
-
-							if (descriptor.is_directory)
-							{
-								append_state(StateCategory::RENAMING_DIRECTORY);
-							}
-							else
+							if (ImGui::MenuItem("Rename"))
 							{
-								append_state(StateCategory::RENAMING_FILE);
+								file_descriptors_.select_none();
+								file_descriptors_.select(index);
+
+								edit_rename_file_or_directory_buffer_.capacity = name.size() + 1;
+								edit_rename_file_or_directory_buffer_.data = std::make_unique_for_overwrite<char[]>(edit_rename_file_or_directory_buffer_.capacity);
+								edit_rename_file_or_directory_buffer_.data[name.size()] = '\0';
+
+								std::ranges::copy(name, edit_rename_file_or_directory_buffer_.data.get());
+
+								if (descriptor.is_directory)
+								{
+									append_state(StateCategory::RENAMING_DIRECTORY);
+								}
+								else
+								{
+									append_state(StateCategory::RENAMING_FILE);
+								}
+								append_state(StateCategory::FOCUSING_EDITOR_NEXT_FRAME);
 							}
-							append_state(StateCategory::FOCUSING_EDITOR_NEXT_FRAME);
 						}
-					}
 
-					if (
-						(has_flag(FileBrowserFlags::ALLOW_DELETE_FILE) == (not descriptor.is_directory)) or
-						(has_flag(FileBrowserFlags::ALLOW_DELETE_DIRECTORY) == descriptor.is_directory)
-					)
-					{
-						if (ImGui::MenuItem("Delete"))
+						if (
+							(has_flag(FileBrowserFlags::ALLOW_DELETE_FILE) == (not descriptor.is_directory)) or
+							(has_flag(FileBrowserFlags::ALLOW_DELETE_DIRECTORY) == descriptor.is_directory)
+						)
 						{
-							selected_filenames_ = {descriptor.name};
+							if (ImGui::MenuItem("Delete"))
+							{
+								file_descriptors_.select_none();
+								file_descriptors_.select(index);
 
-							append_state(StateCategory::DELETE_SELECTED_NEXT_FRAME);
+								append_state(StateCategory::DELETE_SELECTED_NEXT_FRAME);
+							}
 						}
-					}
 
-					ImGui::EndPopup();
+						ImGui::EndPopup();
+					}
 				}
-			}
 
 
-			if (ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left) and ImGui::IsItemHovered())
-			{
-				if (descriptor.is_directory)
+				if (ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left) and ImGui::IsItemHovered())
 				{
-					if (descriptor.name == "..")
+					if (descriptor.is_directory)
 					{
-						working_directory_ = working_directory_.parent_path();
+						if (name == "..")
+						{
+							change_working_directory(working_directory_.parent_path());
+						}
+						else
+						{
+							change_working_directory(working_directory_ / name);
+						}
 					}
-					else
+					else if (not has_flag(FileBrowserFlags::SELECT_DIRECTORY))
 					{
-						working_directory_ = working_directory_ / descriptor.name;
-					}
+						file_descriptors_.select_none();
+						file_descriptors_.select(index);
 
-					append_state(StateCategory::SET_WORKING_DIRECTORY_NEXT_FRAME);
+						append_state(StateCategory::SELECTED);
+						ImGui::CloseCurrentPopup();
+					}
 				}
-				else if (not has_flag(FileBrowserFlags::SELECT_DIRECTORY))
-				{
-					selected_filenames_ = {descriptor.name};
 
-					append_state(StateCategory::SELECTED);
-					ImGui::CloseCurrentPopup();
+				// after the interactions above, they refer to the selectable (last item)
+				if (table_view)
+				{
+					show_file_descriptor_columns(index);
 				}
 			}
 		}
+
+		if (not thumbnail_requests_.empty())
+		{
+			thumbnail_loader_->submit(thumbnail_requests_);
+		}
+
+		// the requests of EndMultiSelect are applied after the items were drawn, the next frame shows them
+		const auto* end_multi_select_io = ImGui::EndMultiSelect();
+		if (not end_multi_select_io->Requests.empty())
+		{
+			append_state(StateCategory::REDRAW_REQUIRED);
+		}
+		apply_selection_requests(*end_multi_select_io);
 	}
 
 	auto FileBrowser::show_files_window_context_on_creating() noexcept -> void
 	{
-		const auto select_directory = has_flag(FileBrowserFlags::SELECT_DIRECTORY);
-		const auto hide_regular_files = select_directory and has_flag(FileBrowserFlags::HIDE_REGULAR_FILES);
+		const auto table_view = is_table_view();
 
-		for (const auto& descriptor: file_descriptors_)
+		ImGuiListClipper clipper{};
+		clipper.Begin(static_cast<int>(file_descriptors_view_.size()));
+		while (clipper.Step())
 		{
-			if (not descriptor.is_directory)
+			for (auto row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
 			{
-				if (hide_regular_files)
+				const auto index = file_descriptors_view_[static_cast<std::size_t>(row)];
+
+				if (table_view)
 				{
-					continue;
+					ImGui::TableNextRow();
+					ImGui::TableNextColumn();
 				}
 
-				if (not is_filter_matched(descriptor.extension))
+				ImGui::Selectable(file_descriptors_.display_name(index), false, ImGuiSelectableFlags_NoAutoClosePopups);
+
+				if (table_view)
 				{
-					continue;
+					show_file_descriptor_columns(index);
 				}
 			}
+		}
 
-			ImGui::Selectable(descriptor.display_name.c_str(), false, ImGuiSelectableFlags_NoAutoClosePopups);
+		if (table_view)
+		{
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
 		}
 
 		if (has_state(StateCategory::FOCUSING_EDITOR_NEXT_FRAME))
@@ -986,7 +5684,7 @@ namespace ImGui
 				const std::string_view view{edit_create_file_or_directory_buffer_.data.get(), edit_create_file_or_directory_buffer_.data.get() + static_cast<std::ptrdiff_t>(length)};
 
 				if (const auto full_path = working_directory_ / view;
-					exists(full_path))
+					IMFB_STATISTICS_CALL(StatisticsPhase::FILESYSTEM_STATUS, exists(full_path)))
 				{
 					tooltip_ = std::format(
 						"{} {} already exist, operation cancelled.",
@@ -998,11 +5696,11 @@ namespace ImGui
 				{
 					if (file)
 					{
-						if (std::ofstream new_file{full_path};
+						if (auto new_file = IMFB_STATISTICS_CALL(StatisticsPhase::FILESYSTEM_CREATE, std::ofstream{full_path});
 							new_file.is_open())
 						{
 							new_file.close();
-							update_file_descriptors();
+							refresh_file_descriptors();
 						}
 						else
 						{
@@ -1013,9 +5711,9 @@ namespace ImGui
 					else
 					{
 						if (std::error_code error_code{};
-							create_directory(full_path, error_code))
+							IMFB_STATISTICS_CALL(StatisticsPhase::FILESYSTEM_CREATE, create_directory(full_path, error_code)))
 						{
-							update_file_descriptors();
+							refresh_file_descriptors();
 						}
 						else
 						{
@@ -1029,121 +5727,215 @@ namespace ImGui
 
 	auto FileBrowser::show_files_window_context_on_renaming() noexcept -> void
 	{
-		const auto select_directory = has_flag(FileBrowserFlags::SELECT_DIRECTORY);
-		const auto hide_regular_files = select_directory and has_flag(FileBrowserFlags::HIDE_REGULAR_FILES);
+		const auto renaming_index = file_descriptors_.first_selected();
+		const auto table_view = is_table_view();
 
-		for (const auto& descriptor: file_descriptors_)
+		ImGuiListClipper clipper{};
+		clipper.Begin(static_cast<int>(file_descriptors_view_.size()));
+
+		// the editor must be submitted every frame, even if it is scrolled out of view, otherwise it loses the focus
+		if (renaming_index < file_descriptors_view_rows_.size() and
+			file_descriptors_view_rows_[renaming_index] != std::numeric_limits<std::uint32_t>::max())
 		{
-			if (not descriptor.is_directory)
+			clipper.IncludeItemByIndex(static_cast<int>(file_descriptors_view_rows_[renaming_index]));
+		}
+
+		while (clipper.Step())
+		{
+			for (auto row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
 			{
-				if (hide_regular_files)
-				{
-					continue;
-				}
+				const auto index = file_descriptors_view_[static_cast<std::size_t>(row)];
 
-				if (not is_filter_matched(descriptor.extension))
+				if (table_view)
 				{
-					continue;
+					ImGui::TableNextRow();
+					ImGui::TableNextColumn();
 				}
-			}
 
-			if (descriptor.name != *selected_filenames_.begin())
-			{
-				ImGui::Selectable(descriptor.display_name.c_str(), false, ImGuiSelectableFlags_NoAutoClosePopups);
-			}
-			else
-			{
-				if (has_state(StateCategory::FOCUSING_EDITOR_NEXT_FRAME))
+				if (index != renaming_index)
 				{
-					ImGui::SetKeyboardFocusHere();
+					ImGui::Selectable(file_descriptors_.display_name(index), false, ImGuiSelectableFlags_NoAutoClosePopups);
 				}
-
-				ImGui::PushItemWidth(-1);
-				ImGui::InputText(
-					"##rename_file_or_directory",
-					edit_rename_file_or_directory_buffer_.data.get(),
-					edit_rename_file_or_directory_buffer_.capacity,
-					ImGuiInputTextFlags_CallbackResize | ImGuiInputTextFlags_AutoSelectAll,
-					expand_string_buffer,
-					&edit_rename_file_or_directory_buffer_
-				);
-				ImGui::PopItemWidth();
-
-				clear_state(StateCategory::FOCUSING_EDITOR_NEXT_FRAME);
-
-				if (ImGui::IsItemDeactivatedAfterEdit())
+				else
 				{
-					const auto file = has_state(StateCategory::RENAMING_FILE);
+					const auto name = file_descriptors_.name(index);
 
-					if (file)
-					{
-						clear_state(StateCategory::RENAMING_FILE);
-					}
-					else
+					if (has_state(StateCategory::FOCUSING_EDITOR_NEXT_FRAME))
 					{
-						clear_state(StateCategory::RENAMING_DIRECTORY);
+						ImGui::SetKeyboardFocusHere();
 					}
 
-					const auto length = std::strlen(edit_rename_file_or_directory_buffer_.data.get());
-					edit_rename_file_or_directory_buffer_.data[length] = '\0';
+					ImGui::PushItemWidth(-1);
+					ImGui::InputText(
+						"##rename_file_or_directory",
+						edit_rename_file_or_directory_buffer_.data.get(),
+						edit_rename_file_or_directory_buffer_.capacity,
+						ImGuiInputTextFlags_CallbackResize | ImGuiInputTextFlags_AutoSelectAll,
+						expand_string_buffer,
+						&edit_rename_file_or_directory_buffer_
+					);
+					ImGui::PopItemWidth();
+
+					clear_state(StateCategory::FOCUSING_EDITOR_NEXT_FRAME);
 
-					if (length == 0)
+					if (ImGui::IsItemDeactivatedAfterEdit())
 					{
+						const auto file = has_state(StateCategory::RENAMING_FILE);
+
 						if (file)
 						{
-							tooltip_ = "Empty file name, operation cancelled.";
+							clear_state(StateCategory::RENAMING_FILE);
 						}
 						else
 						{
-							tooltip_ = "Empty directory name, operation cancelled.";
+							clear_state(StateCategory::RENAMING_DIRECTORY);
 						}
-					}
-					else
-					{
-						const std::string_view view{edit_rename_file_or_directory_buffer_.data.get(), edit_rename_file_or_directory_buffer_.data.get() + static_cast<std::ptrdiff_t>(length)};
-
-						const auto old_path = working_directory_ / descriptor.name;
-						const auto new_path = working_directory_ / view;
 
-						std::error_code error_code{};
-						std::filesystem::rename(old_path, new_path, error_code);
+						const auto length = std::strlen(edit_rename_file_or_directory_buffer_.data.get());
+						edit_rename_file_or_directory_buffer_.data[length] = '\0';
 
-						if (error_code)
+						if (length == 0)
 						{
-							tooltip_ = std::format(
-								"Error occurred while renaming\n\t{} to {}\n{}",
-								descriptor.name.string(),
-								view,
-								error_code.message()
-							);
+							if (file)
+							{
+								tooltip_ = "Empty file name, operation cancelled.";
+							}
+							else
+							{
+								tooltip_ = "Empty directory name, operation cancelled.";
+							}
+						}
+						else
+						{
+							const std::string_view view{edit_rename_file_or_directory_buffer_.data.get(), edit_rename_file_or_directory_buffer_.data.get() + static_cast<std::ptrdiff_t>(length)};
+
+							const auto old_path = working_directory_ / name;
+							const auto new_path = working_directory_ / view;
+
+							std::error_code error_code{};
+							IMFB_STATISTICS_CALL(StatisticsPhase::FILESYSTEM_RENAME, std::filesystem::rename(old_path, new_path, error_code));
+
+							if (error_code)
+							{
+								tooltip_ = std::format(
+									"Error occurred while renaming\n\t{} to {}\n{}",
+									name,
+									view,
+									error_code.message()
+								);
+							}
+
+							refresh_file_descriptors();
 						}
 
-						update_file_descriptors();
+						// the listing may have changed, the indices are outdated
+						return;
 					}
 				}
+
+				if (table_view)
+				{
+					show_file_descriptor_columns(index);
+				}
 			}
 		}
 	}
 
+	auto FileBrowser::show_search_box() noexcept -> void
+	{
+		ImGui::SetNextItemWidth(-1);
+		ImGui::InputTextWithHint("##search", "Search", search_buffer_.data(), search_buffer_.size());
+	}
+
 	auto FileBrowser::show_files_window() noexcept -> void
 	{
+		IMFB_STATISTICS_SCOPE(StatisticsPhase::SHOW_FILES_WINDOW);
+
 		const auto height = ImGui::GetFrameHeightWithSpacing();
 
-		ImGui::BeginChild(
-			"files",
-			{0, -height},
-			ImGuiChildFlags_Borders
-		);
+		if (has_flag(FileBrowserFlags::SEARCH_BOX))
+		{
+			show_search_box();
+		}
+
+		if (has_state(StateCategory::SCAN_LIMITED))
+		{
+			// drop parent folder path
+			ImGui::TextDisabled("%zu entries loaded", file_descriptors_.size() - 1);
+			ImGui::SameLine();
+			if (ImGui::SmallButton("Load more"))
+			{
+				load_more_file_descriptors();
+			}
+		}
+		else if (has_state(StateCategory::SCANNING))
+		{
+			// drop parent folder path
+			ImGui::TextDisabled("Loading... (%zu entries)", file_descriptors_.size() - 1);
+		}
+
+		const auto table_view = is_table_view();
+
+		if (table_view)
+		{
+			// the table scrolls itself (the header stays visible)
+			if (not ImGui::BeginTable(
+				"files",
+				6,
+				ImGuiTableFlags_Sortable |
+				ImGuiTableFlags_SortMulti |
+				ImGuiTableFlags_Resizable |
+				ImGuiTableFlags_Reorderable |
+				ImGuiTableFlags_Hideable |
+				ImGuiTableFlags_RowBg |
+				ImGuiTableFlags_BordersOuter |
+				ImGuiTableFlags_BordersInnerV |
+				ImGuiTableFlags_ScrollY,
+				{0, -height}
+			))
+			{
+				return;
+			}
+
+			setup_files_table();
+		}
+		else
+		{
+			show_files_sort_header();
+
+			ImGui::BeginChild(
+				"files",
+				{0, -height},
+				ImGuiChildFlags_Borders
+			);
+		}
 		ScopeGuard child_guard
 		{
-				[]
+				[table_view]
 				{
-					ImGui::EndChild();
+					if (table_view)
+					{
+						ImGui::EndTable();
+					}
+					else
+					{
+						ImGui::EndChild();
+					}
 				}
 		};
 
-		const auto creating_file_or_directory = has_state(StateCategory::CREATING) and (selected_filenames_.empty());
-		const auto renaming_file_or_directory = has_state(StateCategory::RENAMING) and (selected_filenames_.size() == 1);
+		if (has_state(StateCategory::SORT_DIRTY))
+		{
+			order_file_descriptors();
+		}
+
+		// only the extensions interned since the last frame are matched against the filters
+		update_filter_mask();
+		update_search();
+		update_file_descriptors_view();
+
+		const auto creating_file_or_directory = has_state(StateCategory::CREATING) and (file_descriptors_.selected_count() == 0);
+		const auto renaming_file_or_directory = has_state(StateCategory::RENAMING) and (file_descriptors_.selected_count() == 1);
 
 		assert(
 			(creating_file_or_directory == false and renaming_file_or_directory == false) or
@@ -1162,44 +5954,12 @@ namespace ImGui
 		{
 			show_files_window_context();
 		}
-
-		if (not is_state_editing())
-		{
-			if (const auto select_all =
-						has_flag(FileBrowserFlags::MULTIPLE_SELECTION) and
-						(ImGui::IsKeyDown(ImGuiKey_LeftCtrl) or ImGui::IsKeyDown(ImGuiKey_RightCtrl)) and
-						ImGui::IsKeyPressed(ImGuiKey_A);
-				select_all)
-			{
-				selected_filenames_.clear();
-
-				std::ranges::for_each(
-					// drop parent folder path
-					file_descriptors_ | std::views::drop(1),
-					[&](const file_descriptor& descriptor) noexcept -> void
-					{
-						if (has_flag(FileBrowserFlags::SELECT_DIRECTORY))
-						{
-							if (descriptor.is_directory)
-							{
-								selected_filenames_.insert(descriptor.name);
-							}
-						}
-						else
-						{
-							if (not descriptor.is_directory and is_filter_matched(descriptor.extension))
-							{
-								selected_filenames_.insert(descriptor.name);
-							}
-						}
-					}
-				);
-			}
-		}
 	}
 
 	auto FileBrowser::show_bottom_tools() noexcept -> void
 	{
+		IMFB_STATISTICS_SCOPE(StatisticsPhase::SHOW_BOTTOM_TOOLS);
+
 		// OK
 		{
 			const auto confirm_by_enter =
@@ -1220,11 +5980,13 @@ namespace ImGui
 			}
 			else
 			{
-				ImGui::BeginDisabled(selected_filenames_.empty());
+				const auto nothing_selected = file_descriptors_.selected_count() == 0;
+
+				ImGui::BeginDisabled(nothing_selected);
 				const auto ok = ImGui::Button("OK");
 				ImGui::EndDisabled();
 
-				if ((ok or confirm_by_enter) and not selected_filenames_.empty())
+				if ((ok or confirm_by_enter) and not nothing_selected)
 				{
 					append_state(StateCategory::SELECTED);
 					ImGui::CloseCurrentPopup();
@@ -1246,6 +6008,8 @@ namespace ImGui
 			if (ImGui::Button("Cancel") or has_state(StateCategory::CLOSING) or close_by_escape)
 			{
 				ImGui::CloseCurrentPopup();
+				// the popup is still drawn this frame
+				append_state(StateCategory::REDRAW_REQUIRED);
 			}
 		}
 
@@ -1262,6 +6026,7 @@ namespace ImGui
 						ImGui::Selectable(filter.c_str(), selected) and not selected)
 					{
 						selected_filter_ = index;
+						reset_filter_mask();
 					}
 				}
 
@@ -1271,7 +6036,16 @@ namespace ImGui
 		}
 	}
 
-	FileBrowser::~FileBrowser() noexcept = default;
+	FileBrowser::~FileBrowser() noexcept
+	{
+		cancel_file_descriptors_scanning();
+		stop_file_metadata_fetching();
+
+		if (directory_prefetcher_)
+		{
+			directory_prefetcher_->cancel();
+		}
+	}
 
 	FileBrowser::FileBrowser(
 		const std::string_view title,
@@ -1293,10 +6067,35 @@ namespace ImGui
 		  states_{StateCategory::NONE},
 #endif
 		  working_directory_{std::move(open_directory)},
+		  breadcrumb_{.path = {}, .labels = {}, .segments = {}, .font = nullptr, .font_size = 0, .trailing_text_width = 0, .overflow_text_width = 0, .layout_width = -1, .first_visible = 1},
 		  edit_working_directory_buffer_{.data = nullptr, .capacity = 0},
 		  edit_create_file_or_directory_buffer_{.data = nullptr, .capacity = 0},
 		  edit_rename_file_or_directory_buffer_{.data = nullptr, .capacity = 0},
-		  selected_filter_{0}
+		  selected_filter_{0},
+		  filter_mask_size_{0},
+		  scan_limit_{0},
+		  file_descriptors_generation_{0},
+		  file_descriptors_revision_{0},
+		  column_orders_{},
+		  prefetch_hovered_index_{0},
+		  metadata_sweep_cursor_{0},
+		  file_metadata_revision_{0},
+		  file_descriptors_order_cost_{0},
+		  metadata_order_deadline_{},
+		  type_ahead_prefix_{},
+		  type_ahead_prefix_size_{0},
+		  type_ahead_time_{0},
+		  type_ahead_row_{-1},
+		  search_buffer_{},
+		  search_revision_{0},
+		  search_size_{0},
+		  redraw_deadline_{},
+#if IMFB_STATISTICS
+		  statistics_{},
+#endif
+		  thumbnail_cache_capacity_{default_thumbnail_cache_capacity},
+		  thumbnail_size_{default_thumbnail_size},
+		  thumbnail_first_line_{0}
 	{
 #if IMFB_DEBUG
 		std::memset(&states_, 0, sizeof(States::value_type));
@@ -1308,6 +6107,12 @@ namespace ImGui
 				.capacity = 64,
 		};
 		edit_create_file_or_directory_buffer_.data[0] = '\0';
+
+		// a digit run of the prefix grows by two bytes once folded (SortOrder::NATURAL)
+		type_ahead_key_.reserve(type_ahead_capacity * 2 + 2);
+		search_query_.reserve(search_capacity);
+
+		update_breadcrumb();
 	}
 
 	FileBrowser::FileBrowser(
@@ -1364,6 +6169,7 @@ namespace ImGui
 	{
 		title_ = title;
 		title_label_ = make_title_label(title_);
+		append_state(StateCategory::REDRAW_REQUIRED);
 	}
 
 	auto FileBrowser::get_position_x() const noexcept -> size_type
@@ -1386,12 +6192,14 @@ namespace ImGui
 	{
 		x_ = x;
 		append_state(StateCategory::POSITION_DIRTY);
+		append_state(StateCategory::REDRAW_REQUIRED);
 	}
 
 	auto FileBrowser::set_position_y(const size_type y) noexcept -> void
 	{
 		y_ = y;
 		append_state(StateCategory::POSITION_DIRTY);
+		append_state(StateCategory::REDRAW_REQUIRED);
 	}
 
 	auto FileBrowser::get_size_width() const noexcept -> size_type
@@ -1415,6 +6223,7 @@ namespace ImGui
 		assert(width > 0);
 
 		width_ = width;
+		append_state(StateCategory::REDRAW_REQUIRED);
 	}
 
 	auto FileBrowser::set_size_height(const size_type height) noexcept -> void
@@ -1422,6 +6231,7 @@ namespace ImGui
 		assert(height > 0);
 
 		height_ = height;
+		append_state(StateCategory::REDRAW_REQUIRED);
 	}
 
 	auto FileBrowser::has_flag(const FileBrowserFlags flag) const noexcept -> bool
@@ -1436,7 +6246,16 @@ namespace ImGui
 
 	auto FileBrowser::append_flags(const FileBrowserFlags flags) noexcept -> void
 	{
+		const auto sort_order = get_sort_order();
+
 		flags_ = static_cast<FileBrowserFlags>(std::to_underlying(flags_) | std::to_underlying(flags));
+		append_state(StateCategory::VIEW_DIRTY);
+		append_state(StateCategory::REDRAW_REQUIRED);
+
+		if (sort_order != get_sort_order())
+		{
+			sort_file_descriptors();
+		}
 	}
 
 	auto FileBrowser::append_flags(const std::initializer_list<FileBrowserFlags> flags) noexcept -> void
@@ -1452,13 +6271,28 @@ namespace ImGui
 
 	auto FileBrowser::set_flags(const FileBrowserFlags flags) noexcept -> void
 	{
+		const auto sort_order = get_sort_order();
+
 		flags_ = flags;
+		append_state(StateCategory::VIEW_DIRTY);
+		append_state(StateCategory::REDRAW_REQUIRED);
+
+		if (sort_order != get_sort_order())
+		{
+			sort_file_descriptors();
+		}
 	}
 
 	auto FileBrowser::set_flags(const std::initializer_list<FileBrowserFlags> flags) noexcept -> void
 	{
-		set_flags(FileBrowserFlags::NONE);
-		append_flags(flags);
+		// combined first, the listing is sorted again at most once
+		auto combined = FileBrowserFlags::NONE;
+		for (const auto flag: flags)
+		{
+			combined = static_cast<FileBrowserFlags>(std::to_underlying(combined) | std::to_underlying(flag));
+		}
+
+		set_flags(combined);
 	}
 
 	auto FileBrowser::get_working_directory() const noexcept -> const std::filesystem::path&
@@ -1469,18 +6303,37 @@ namespace ImGui
 	auto FileBrowser::set_working_directory(const std::filesystem::path& directory) noexcept -> bool
 	{
 		std::error_code error_code{};
-		auto new_working_directory = absolute(directory, error_code);
+		auto new_working_directory = IMFB_STATISTICS_CALL(StatisticsPhase::FILESYSTEM_STATUS, absolute(directory, error_code));
 
 		if (error_code)
 		{
 			return false;
 		}
 
+		if (new_working_directory != working_directory_)
+		{
+			// the selection belongs to the previous working directory
+			file_descriptors_.select_none();
+			reselected_filenames_.clear();
+		}
+
 		working_directory_ = std::move(new_working_directory);
+		update_breadcrumb();
 		update_file_descriptors();
 		return true;
 	}
 
+	auto FileBrowser::get_scan_limit() const noexcept -> std::size_t
+	{
+		return scan_limit_;
+	}
+
+	auto FileBrowser::set_scan_limit(const std::size_t limit) noexcept -> void
+	{
+		// applied by the next enumeration
+		scan_limit_ = limit;
+	}
+
 	auto FileBrowser::is_opened() const noexcept -> bool
 	{
 		return has_state(StateCategory::OPENED);
@@ -1510,6 +6363,11 @@ namespace ImGui
 
 	auto FileBrowser::show() noexcept -> void
 	{
+		IMFB_STATISTICS_SCOPE(StatisticsPhase::SHOW);
+
+		// everything changed so far is drawn by this frame
+		clear_state(StateCategory::REDRAW_REQUIRED);
+
 		ImGui::PushID(this);
 		ScopeGuard id_guard
 		{
@@ -1577,6 +6435,8 @@ namespace ImGui
 
 		if (has_state(StateCategory::SET_WORKING_DIRECTORY_NEXT_FRAME))
 		{
+			IMFB_STATISTICS_SCOPE(StatisticsPhase::SET_WORKING_DIRECTORY);
+
 			set_working_directory(working_directory_);
 			clear_state(StateCategory::SET_WORKING_DIRECTORY_NEXT_FRAME);
 
@@ -1584,23 +6444,31 @@ namespace ImGui
 		}
 		if (has_state(StateCategory::DELETE_SELECTED_NEXT_FRAME))
 		{
+			IMFB_STATISTICS_SCOPE(StatisticsPhase::DELETE_SELECTED);
+
 			clear_state(StateCategory::DELETE_SELECTED_NEXT_FRAME);
 
 			std::error_code error_code{};
 
 			std::string tooltip{"Error occurred:\n"};
-			for (const auto& filename: selected_filenames_)
+			for (std::size_t index = file_descriptors_.first_selected(); index < file_descriptors_.size(); ++index)
 			{
+				if (not file_descriptors_.is_selected(index))
+				{
+					continue;
+				}
+
+				const auto filename = file_descriptors_.name(index);
 				const auto full_path = working_directory_ / filename;
 				// remove(full_path, error_code);
-				remove_all(full_path, error_code);
+				IMFB_STATISTICS_CALL(StatisticsPhase::FILESYSTEM_REMOVE, remove_all(full_path, error_code));
 
 				if (error_code)
 				{
 					std::format_to(
 						std::back_inserter(tooltip),
 						"\t{}\n\t\t{}\n",
-						filename.string(),
+						filename,
 						error_code.message()
 					);
 				}
@@ -1612,7 +6480,16 @@ namespace ImGui
 			}
 
 			clear_selected();
-			update_file_descriptors();
+			refresh_file_descriptors();
+		}
+
+		{
+			IMFB_STATISTICS_SCOPE(StatisticsPhase::POLL);
+
+			poll_file_descriptors();
+			poll_directory_watcher();
+			poll_file_metadata();
+			poll_thumbnails();
 		}
 
 		show_working_path();
@@ -1622,6 +6499,49 @@ namespace ImGui
 		show_files_window();
 
 		show_bottom_tools();
+
+		request_file_metadata();
+
+		update_redraw_state();
+	}
+
+	auto FileBrowser::needs_redraw() const noexcept -> bool
+	{
+		if (has_state(StateCategory::OPENING) or has_state(StateCategory::CLOSING))
+		{
+			return true;
+		}
+
+		// nothing is shown
+		if (not has_state(StateCategory::OPENED))
+		{
+			return false;
+		}
+
+		if (has_state(StateCategory::REDRAW_REQUIRED))
+		{
+			return true;
+		}
+
+		const auto now = std::chrono::steady_clock::now();
+
+		if (redraw_deadline_ != std::chrono::steady_clock::time_point{} and now < redraw_deadline_)
+		{
+			return true;
+		}
+
+		// the results of the workers, applied by the next show()
+		// a synchronous scan paused at the scan limit has no worker, nothing to report
+		const auto polled_state = has_state(StateCategory::SCAN_LIMITED) ? DirectoryScanner::ScanState::LIMITED : DirectoryScanner::ScanState::RUNNING;
+		const auto scanned = directory_scanner_ and has_state(StateCategory::SCANNING) and directory_scanner_->has_results(polled_state);
+		const auto watched = directory_watcher_ and directory_watcher_->has_events();
+
+		return
+				scanned or
+				watched or
+				(metadata_fetcher_ and metadata_fetcher_->has_results()) or
+				(metadata_order_deadline_ != std::chrono::steady_clock::time_point{} and now >= metadata_order_deadline_) or
+				(thumbnail_loader_ and thumbnail_loader_->has_results());
 	}
 
 	auto FileBrowser::has_selected() const noexcept -> bool
@@ -1631,39 +6551,55 @@ namespace ImGui
 
 	auto FileBrowser::get_selected() const noexcept -> std::filesystem::path
 	{
-		if (selected_filenames_.empty())
+		const auto index = file_descriptors_.first_selected();
+
+		if (index == file_descriptors_.size())
 		{
 			return working_directory_;
 		}
 
-		return working_directory_ / *selected_filenames_.begin();
+		return working_directory_ / file_descriptors_.name(index);
 	}
 
 	auto FileBrowser::get_all_selected() const noexcept -> std::vector<std::filesystem::path>
 	{
-		if (selected_filenames_.empty())
+		const auto count = file_descriptors_.selected_count();
+
+		if (count == 0)
 		{
 			return {working_directory_};
 		}
 
+		// the paths are only constructed here
 		std::vector<std::filesystem::path> results{};
-		results.reserve(selected_filenames_.size());
+		results.reserve(count);
 
-		std::ranges::transform(
-			selected_filenames_,
-			std::back_inserter(results),
-			[this](const std::filesystem::path& filename) noexcept -> std::filesystem::path
+		for (std::size_t index = file_descriptors_.first_selected(); index < file_descriptors_.size(); ++index)
+		{
+			if (file_descriptors_.is_selected(index))
 			{
-				return working_directory_ / filename;
+				results.emplace_back(working_directory_ / file_descriptors_.name(index));
 			}
-		);
+		}
 
 		return results;
 	}
 
+	auto FileBrowser::set_selected(const std::string_view filename) noexcept -> void
+	{
+		file_descriptors_.select_none();
+		reselected_filenames_.clear();
+
+		reselected_filenames_.emplace_back(filename, has_flag(FileBrowserFlags::SELECT_DIRECTORY));
+		reselect_file_descriptors();
+
+		append_state(StateCategory::REDRAW_REQUIRED);
+	}
+
 	auto FileBrowser::clear_selected() noexcept -> void
 	{
-		selected_filenames_.clear();
+		file_descriptors_.select_none();
+		reselected_filenames_.clear();
 
 		clear_state(StateCategory::SELECTED);
 	}
@@ -1675,14 +6611,16 @@ namespace ImGui
 
 	auto FileBrowser::set_filter(const std::span<const std::string_view> filters) noexcept -> void
 	{
-		do_set_filters(filters_, filters);
+		do_set_filters(filters_, filter_matchers_, filters);
 		selected_filter_ = 0;
+		reset_filter_mask();
 	}
 
 	auto FileBrowser::set_filter(const std::span<const std::string> filters) noexcept -> void
 	{
-		do_set_filters(filters_, filters);
+		do_set_filters(filters_, filter_matchers_, filters);
 		selected_filter_ = 0;
+		reset_filter_mask();
 	}
 
 	auto FileBrowser::set_filter(const std::vector<std::string>& filters) noexcept -> void
@@ -1693,5 +6631,160 @@ namespace ImGui
 	auto FileBrowser::clear_filter() noexcept -> void
 	{
 		filters_.clear();
+		filter_matchers_.clear();
+		reset_filter_mask();
+	}
+
+	auto FileBrowser::get_search_query() const noexcept -> std::string_view
+	{
+		// null-terminated
+		return search_buffer_.data();
+	}
+
+	auto FileBrowser::set_search_query(const std::string_view query) noexcept -> void
+	{
+		const auto size = std::ranges::min(query.size(), search_buffer_.size() - 1);
+
+		std::ranges::copy_n(query.begin(), static_cast<std::ptrdiff_t>(size), search_buffer_.begin());
+		search_buffer_[size] = '\0';
+
+		append_state(StateCategory::REDRAW_REQUIRED);
+	}
+
+	auto FileBrowser::set_listing_cache_capacity(const std::size_t bytes) noexcept -> void
+	{
+		ListingCache::instance().set_capacity(bytes);
+	}
+
+	auto FileBrowser::clear_listing_cache() noexcept -> void
+	{
+		ListingCache::instance().clear();
+	}
+
+	auto FileBrowser::set_thumbnail_provider(std::shared_ptr<ThumbnailProvider> provider, thumbnail_upload_type upload, thumbnail_release_type release) noexcept -> void
+	{
+		// the cached textures belong to the previous host callbacks
+		thumbnail_cache_.reset();
+
+		thumbnail_provider_ = std::move(provider);
+		thumbnail_upload_ = std::move(upload);
+		if (thumbnail_provider_)
+		{
+			thumbnail_cache_ = std::make_shared<ThumbnailCache>(std::move(release), thumbnail_cache_capacity_);
+		}
+
+		reset_thumbnails();
+	}
+
+	auto FileBrowser::get_thumbnail_size() const noexcept -> std::uint32_t
+	{
+		return thumbnail_size_;
+	}
+
+	auto FileBrowser::set_thumbnail_size(const std::uint32_t size) noexcept -> void
+	{
+		if (size == 0 or size == thumbnail_size_)
+		{
+			return;
+		}
+
+		thumbnail_size_ = size;
+		reset_thumbnails();
+	}
+
+	auto FileBrowser::set_thumbnail_cache_capacity(const std::size_t bytes) noexcept -> void
+	{
+		thumbnail_cache_capacity_ = bytes;
+		if (thumbnail_cache_)
+		{
+			thumbnail_cache_->set_capacity(bytes);
+			thumbnail_cache_->evict();
+			append_state(StateCategory::REDRAW_REQUIRED);
+		}
+	}
+
+#if IMFB_STATISTICS
+	auto FileBrowser::get_statistics(const StatisticsPhase phase) const noexcept -> const statistics_type&
+	{
+		return statistics_[std::to_underlying(phase)];
 	}
+
+	auto FileBrowser::reset_statistics() noexcept -> void
+	{
+		statistics_.fill({});
+	}
+
+	auto FileBrowser::show_statistics() noexcept -> void
+	{
+		constexpr std::array<const char*, statistics_phase_count> phase_names
+		{
+				"show",
+				"set working directory",
+				"delete selected",
+				"poll",
+				"working path",
+				"files window",
+				"search",
+				"bottom tools",
+				"filesystem: list",
+				"filesystem: status",
+				"filesystem: create",
+				"filesystem: rename",
+				"filesystem: remove",
+		};
+
+		const auto to_milliseconds = [](const std::chrono::nanoseconds duration) noexcept -> double
+		{
+			return std::chrono::duration<double, std::milli>{duration}.count();
+		};
+
+		ImGui::PushID(this);
+		ScopeGuard id_guard
+		{
+				[]
+				{
+					ImGui::PopID();
+				}
+		};
+
+		ImGui::SetNextWindowBgAlpha(0.75f);
+		if (ImGui::Begin(std::format("{} statistics###statistics", title_).c_str(), nullptr, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoFocusOnAppearing))
+		{
+			if (ImGui::Button("Reset"))
+			{
+				reset_statistics();
+			}
+
+			if (ImGui::BeginTable("statistics", 5, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV))
+			{
+				ImGui::TableSetupColumn("Phase");
+				ImGui::TableSetupColumn("Last (ms)");
+				ImGui::TableSetupColumn("Average (ms)");
+				ImGui::TableSetupColumn("Max (ms)");
+				ImGui::TableSetupColumn("Count");
+				ImGui::TableHeadersRow();
+
+				for (std::size_t phase = 0; phase < statistics_phase_count; ++phase)
+				{
+					const auto& statistics = statistics_[phase];
+
+					ImGui::TableNextRow();
+					ImGui::TableNextColumn();
+					ImGui::TextUnformatted(phase_names[phase]);
+					ImGui::TableNextColumn();
+					ImGui::Text("%.3f", to_milliseconds(statistics.last));
+					ImGui::TableNextColumn();
+					ImGui::Text("%.3f", to_milliseconds(statistics.average()));
+					ImGui::TableNextColumn();
+					ImGui::Text("%.3f", to_milliseconds(statistics.max));
+					ImGui::TableNextColumn();
+					ImGui::Text("%llu", static_cast<unsigned long long>(statistics.count));
+				}
+
+				ImGui::EndTable();
+			}
+		}
+		ImGui::End();
+	}
+#endif
 }
@@ -13,9 +13,20 @@
 
 #endif
 
+// per-phase timing of FileBrowser::show, see FileBrowser::get_statistics
+// it adds members to FileBrowser, so the library and every translation unit including this header must agree on it (the CMake target always defines it, 0 or 1)
+#if not defined(IMFB_STATISTICS)
+#define IMFB_STATISTICS 0
+#endif
+
+#include <array>
 #include <vector>
+#include <chrono>
 #include <filesystem>
+#include <functional>
+#include <memory>
 #include <span>
+#include <unordered_map>
 #include <unordered_set>
 
 // ReSharper disable once CppInconsistentNaming
@@ -66,6 +77,42 @@ namespace ImGui
 		ALLOW_DELETE_FILE = 1 << 15,
 		ALLOW_DELETE_DIRECTORY = 1 << 16,
 		ALLOW_DELETE = ALLOW_DELETE_FILE | ALLOW_DELETE_DIRECTORY,
+
+		// show a search field above the entries, the entries matching the query (case-insensitive fuzzy subsequence) are ranked best first
+		SEARCH_BOX = 1 << 17,
+
+		// ============================
+		// SORT
+		// ============================
+
+		// 20~23
+
+		// numeric aware order, "frame_2" < "frame_10" (instead of "frame_10" < "frame_2")
+		NATURAL_SORT = 1 << 20,
+		// show the entries as a table (name / extension / size / modified / type / permissions), the header of the table is the sort header
+		// the metadata columns require FETCH_METADATA
+		TABLE_VIEW = 1 << 21,
+		// show the entries as a grid of thumbnails (see FileBrowser::set_thumbnail_provider), TABLE_VIEW is ignored
+		GRID_VIEW = 1 << 22,
+
+		// ============================
+		// FILESYSTEM
+		// ============================
+
+		// 24~31
+
+		// enumerate the working directory on a background thread, the entries are published batch by batch
+		ASYNC_SCAN = 1 << 24,
+		// fetch size / last write time / permissions of the entries in background, the visible entries first
+		FETCH_METADATA = 1 << 25,
+		// watch the working directory (inotify), created / deleted / renamed entries are applied without a full rescan
+		// fallback to full rescan if the platform is not supported
+		WATCH_DIRECTORY = 1 << 26,
+		// share the listing of the directories through a process-wide LRU cache (validated by the last write / status change time of the directory)
+		// see FileBrowser::set_listing_cache_capacity
+		CACHE_LISTING = 1 << 27,
+		// list the hovered child directory and the parent directory in background (low priority) into the listing cache, implies CACHE_LISTING
+		PREFETCH_DIRECTORIES = 1 << 28,
 	};
 
 	class FileBrowser final
@@ -82,6 +129,182 @@ namespace ImGui
 		constexpr static std::string_view parent_path_name{"(last level)"};
 
 		constexpr static std::string_view wildcard_filter{".*"};
+		// the characters typed into the files window form a prefix, a longer pause starts a new one (seconds)
+		constexpr static double type_ahead_timeout = 1.0;
+		constexpr static std::size_t type_ahead_capacity = 64;
+		// the longest query of the search field (FileBrowserFlags::SEARCH_BOX), including the null terminator
+		constexpr static std::size_t search_capacity = 128;
+
+		// ========================
+		// thumbnail (FileBrowserFlags::GRID_VIEW)
+		// ========================
+
+		struct thumbnail_image_type
+		{
+			std::uint32_t width;
+			std::uint32_t height;
+			// RGBA8, width * height * 4 bytes
+			std::vector<std::uint8_t> pixels;
+		};
+
+		// the bytes of an ImTextureID (sizeof(ImTextureID) <= sizeof(thumbnail_texture_type))
+		using thumbnail_texture_type = std::uint64_t;
+		// called on the UI thread with the decoded pixels, the pixels are released once it returns (0 if the upload failed)
+		using thumbnail_upload_type = std::function<auto(const thumbnail_image_type& image) -> thumbnail_texture_type>;
+		// called on the UI thread once the texture is evicted from the thumbnail cache (or the FileBrowser is destroyed)
+		using thumbnail_release_type = std::function<auto(thumbnail_texture_type texture) -> void>;
+
+		// decodes the thumbnails, called on the worker threads (concurrently)
+		class ThumbnailProvider
+		{
+		public:
+			ThumbnailProvider() noexcept = default;
+			ThumbnailProvider(const ThumbnailProvider&) noexcept = default;
+			ThumbnailProvider(ThumbnailProvider&&) noexcept = default;
+			auto operator=(const ThumbnailProvider&) noexcept -> ThumbnailProvider& = default;
+			auto operator=(ThumbnailProvider&&) noexcept -> ThumbnailProvider& = default;
+
+			virtual ~ThumbnailProvider() noexcept = default;
+
+			// decode the file into an image which fits in size x size, false if the file cannot be decoded (not an image)
+			[[nodiscard]] virtual auto decode(const std::filesystem::path& path, std::uint32_t size, thumbnail_image_type& image) noexcept -> bool = 0;
+		};
+
+		constexpr static std::uint32_t default_thumbnail_size = 96;
+		constexpr static std::size_t default_thumbnail_cache_capacity = 64 * 1024 * 1024;
+
+	private:
+		// the std::string keys are looked up by std::string_view (without constructing a std::string)
+		struct transparent_string_hash
+		{
+			using is_transparent = void;
+
+			[[nodiscard]] auto operator()(std::string_view string) const noexcept -> std::size_t;
+		};
+
+	public:
+		// ========================
+		// filter
+		// ========================
+
+		// the filters compiled once (see set_filter), matching a name does not allocate (case-sensitive)
+		// ".png"                                       plain extension (same as std::filesystem::path::extension), one hash lookup
+		// ".tar.gz"                                    multi-dot extension, the name ends with it
+		// "*_normal.png" / "scene_*.json" / "?.txt"    glob over the whole name, '*' matches any run of bytes, '?' any one byte
+		// ".*" / "*"                                   everything
+		class FilterMatcher
+		{
+		public:
+			// a run of bytes between two '*' ('?' kept)
+			struct segment_type
+			{
+				// offset of the segment in bytes_
+				std::uint32_t offset;
+				std::uint32_t size;
+				// contains '?', cannot be searched with std::string_view::find
+				bool has_any;
+			};
+
+			// a glob split at '*'
+			struct glob_type
+			{
+				// [first_segment, first_segment + segment_count) in segments_, the empty segments are dropped
+				std::uint32_t first_segment;
+				std::uint32_t segment_count;
+				// the sum of the segment sizes, the shorter names are rejected right away
+				std::uint32_t min_size;
+				// no '*' at the front, the first segment is a prefix of the name
+				bool anchored_front;
+				// no '*' at the back, the last segment is a suffix of the name
+				bool anchored_back;
+				// no '*' at all, the name is as long as the glob
+				bool exact;
+			};
+
+		private:
+			std::unordered_set<std::string, transparent_string_hash, std::equal_to<>> extensions_;
+			std::string bytes_;
+			std::vector<segment_type> segments_;
+			std::vector<glob_type> globs_;
+			bool everything_;
+
+			[[nodiscard]] auto segment(const segment_type& segment) const noexcept -> std::string_view;
+
+			[[nodiscard]] auto match_glob(const glob_type& glob, std::string_view name) const noexcept -> bool;
+
+		public:
+			FilterMatcher() noexcept;
+
+			// compile one more filter (the matcher matches the union of its filters)
+			auto add(std::string_view filter) noexcept -> void;
+
+			auto clear() noexcept -> void;
+
+			[[nodiscard]] auto matches_everything() const noexcept -> bool;
+
+			// some filters need the whole name, see match_globs
+			[[nodiscard]] auto has_globs() const noexcept -> bool;
+
+			// the plain extensions only, extension is the extension of the name (see extension_of)
+			[[nodiscard]] auto match_extension(std::string_view extension) const noexcept -> bool;
+
+			// the globs (and multi-dot extensions) only
+			[[nodiscard]] auto match_globs(std::string_view name) const noexcept -> bool;
+
+			[[nodiscard]] auto match(std::string_view name) const noexcept -> bool;
+
+			// same as std::filesystem::path::extension (without the allocation)
+			[[nodiscard]] static auto extension_of(std::string_view name) noexcept -> std::string_view;
+		};
+
+#if IMFB_STATISTICS
+		// ========================
+		// statistics (IMFB_STATISTICS)
+		// ========================
+
+		// the phases nest, SHOW includes all the others and the filesystem calls are included by the phase calling them
+		enum class StatisticsPhase : std::uint8_t
+		{
+			// show() as a whole
+			SHOW,
+			// StateCategory::SET_WORKING_DIRECTORY_NEXT_FRAME, the rescan of the working directory
+			SET_WORKING_DIRECTORY,
+			// StateCategory::DELETE_SELECTED_NEXT_FRAME
+			DELETE_SELECTED,
+			// the results of the workers (scanner / watcher / metadata / thumbnails)
+			POLL,
+			SHOW_WORKING_PATH,
+			// the sort header and the rows
+			SHOW_FILES_WINDOW,
+			// FileBrowserFlags::SEARCH_BOX, the ranking of the entries (only when the query or the listing changed)
+			SEARCH,
+			SHOW_BOTTOM_TOOLS,
+
+			// ========================
+			// filesystem (on the UI thread)
+			// ========================
+
+			// the synchronous enumeration of the working directory
+			FILESYSTEM_LIST,
+			// absolute / is_directory / exists / the listing cache stamp
+			FILESYSTEM_STATUS,
+			FILESYSTEM_CREATE,
+			FILESYSTEM_RENAME,
+			FILESYSTEM_REMOVE,
+		};
+
+		constexpr static std::size_t statistics_phase_count = static_cast<std::size_t>(StatisticsPhase::FILESYSTEM_REMOVE) + 1;
+
+		struct statistics_type
+		{
+			std::chrono::nanoseconds last;
+			std::chrono::nanoseconds total;
+			std::chrono::nanoseconds max;
+			std::uint64_t count;
+
+			[[nodiscard]] auto average() const noexcept -> std::chrono::nanoseconds;
+		};
+#endif
 
 	private:
 		enum class StateCategory : std::uint32_t
@@ -95,6 +318,12 @@ namespace ImGui
 			// 0~3
 
 			POSITION_DIRTY = 1 << 0,
+			// the working directory is being enumerated in background
+			SCANNING = 1 << 1,
+			// the enumeration of the working directory paused at the scan limit, see FileBrowser::set_scan_limit
+			SCAN_LIMITED = 1 << 2,
+			// the display order of the listing is outdated (listing / sort specs / sorted metadata changed)
+			SORT_DIRTY = 1 << 3,
 
 			// ========================
 			// WINDOW
@@ -141,6 +370,17 @@ namespace ImGui
 			RENAMING_FILE = 1 << 19,
 			RENAMING_DIRECTORY = 1 << 20,
 			RENAMING = RENAMING_FILE | RENAMING_DIRECTORY,
+
+			// ========================
+			// STATUS
+			// ========================
+
+			// 24~31
+
+			// the shown rows are outdated (display order / filters / flags changed)
+			VIEW_DIRTY = 1 << 24,
+			// the next frame differs from the last one (see FileBrowser::needs_redraw)
+			REDRAW_REQUIRED = 1 << 25,
 		};
 
 #if IMFB_DEBUG
@@ -157,9 +397,10 @@ namespace ImGui
 			// 0~3
 
 			value_type position_dirty : 1;
-			value_type reserved_status_1 : 1;
-			value_type reserved_status_2 : 1;
-			value_type reserved_status_3 : 1;
+			// the working directory is being enumerated in background
+			value_type scanning : 1;
+			value_type scan_limited : 1;
+			value_type sort_dirty : 1;
 
 			// ========================
 			// WINDOW
@@ -209,18 +450,244 @@ namespace ImGui
 			// editing rename file or directory editor(InputText)
 			value_type renaming_file : 1;
 			value_type renaming_directory : 1;
+			value_type reserved_interactive_21 : 1;
+			value_type reserved_interactive_22 : 1;
+			value_type reserved_interactive_23 : 1;
 
-			value_type reserved : 11;
+			// ========================
+			// STATUS
+			// ========================
+
+			// 24~31
+
+			value_type view_dirty : 1;
+			value_type redraw_required : 1;
+
+			value_type reserved : 6;
 		};
 #endif
 
-		struct file_descriptor
+		struct file_metadata
+		{
+			std::uintmax_t size;
+			std::chrono::system_clock::time_point last_write_time;
+			std::filesystem::perms permissions;
+		};
+
+		enum class MetadataState : std::uint8_t
+		{
+			NONE,
+			// requested, waiting for the fetcher
+			PENDING,
+			READY,
+			UNAVAILABLE,
+		};
+
+		// see FileBrowserFlags::GRID_VIEW
+		enum class ThumbnailState : std::uint8_t
+		{
+			// requested, waiting for the loader
+			PENDING,
+			READY,
+			// the file cannot be decoded
+			UNAVAILABLE,
+			// the request was dropped before being decoded (scrolled out of view)
+			DROPPED,
+		};
+
+		// see FileBrowserFlags::NATURAL_SORT
+		enum class SortOrder : std::uint8_t
 		{
-			std::filesystem::path name;
-			std::filesystem::path extension;
+			LEXICAL,
+			NATURAL,
+		};
+
+		// the columns of the sort header, see FileBrowser::show_files_sort_header
+		enum class SortColumn : std::uint8_t
+		{
+			NAME,
+			EXTENSION,
+			SIZE,
+			LAST_WRITE_TIME,
+			// directory or file
+			TYPE,
+		};
 
-			std::string display_name;
+		struct sort_spec
+		{
+			SortColumn column;
+			bool descending;
+		};
+
+		// the listing by ascending value of a sort column, kept across the re-sorts of the same listing (see FileBrowser::order_file_descriptors)
+		struct column_order
+		{
+			// the file_descriptors_revision_ / file_metadata_revision_ it was built for
+			std::uint32_t revision;
+			std::uint32_t metadata_revision;
+			// indices of file_descriptors_ (without the parent folder path), equal values keep the order of the listing
+			std::vector<std::uint32_t> order;
+			// indexed like file_descriptors_, the rank of the value among the distinct values of the column
+			std::vector<std::uint32_t> ranks;
+			std::uint32_t max_rank;
+		};
+
+		// see file_listing
+		struct file_descriptor
+		{
+			// offset of the name in file_listing::names
+			std::uint32_t name_offset;
+			// offset of the key in file_listing::sort_keys
+			std::uint32_t sort_key_offset;
+			// index in file_listing::extensions
+			std::uint32_t extension;
+			std::uint16_t name_size;
+			std::uint16_t sort_key_size;
 			bool is_directory;
+
+			// lazily filled, see FileBrowserFlags::FETCH_METADATA
+			MetadataState metadata_state;
+		};
+
+		// structure of arrays, the names of all entries live in one contiguous buffer
+		// the buffers are cleared (not freed) on refresh, the removed entries leave holes in the buffers until then
+		struct file_listing
+		{
+			constexpr static std::string_view directory_prefix{"[DIR] "};
+
+			std::vector<file_descriptor> descriptors;
+			// parallel to descriptors
+			std::vector<file_metadata> metadata;
+			// "[DIR] name\0" for directories, "name\0" for files
+			std::string names;
+			// case-folded names (the digit runs are encoded for SortOrder::NATURAL), computed once so that sorting does not allocate
+			std::string sort_keys;
+
+			// bit i: entry i is selected, the bits follow the entries when the listing is reordered
+			std::vector<std::uint64_t> selection;
+			// popcount of selection, ImGui wants it every frame
+			std::size_t selection_size = 0;
+
+			// interned extensions (case-sensitive, same as the filters), [0] is "no extension"
+			// only grows until the listing is cleared, the filters are compiled over it (see FileBrowser::update_filter_mask)
+			std::vector<std::string> extensions;
+			std::unordered_map<std::string, std::uint32_t, transparent_string_hash, std::equal_to<>> extension_ids;
+
+			[[nodiscard]] auto size() const noexcept -> std::size_t;
+
+			[[nodiscard]] auto empty() const noexcept -> bool;
+
+			auto clear() noexcept -> void;
+
+			// the parent folder
+			auto push_parent() noexcept -> void;
+
+			auto push_back(std::string_view name, bool is_directory, SortOrder sort_order) noexcept -> void;
+
+			auto push_error(const std::error_code& error_code) noexcept -> void;
+
+			// append all entries of other (after the entries of this listing), the appended entries are not selected
+			auto append(const file_listing& other, std::size_t first = 0) noexcept -> void;
+
+			auto erase(std::size_t index) noexcept -> void;
+
+			// order[i] is the index of the entry moved to i
+			auto permute(std::span<const std::uint32_t> order) noexcept -> void;
+
+			auto rebuild_sort_keys(SortOrder sort_order) noexcept -> void;
+
+			[[nodiscard]] auto intern_extension(std::string_view extension) noexcept -> std::uint32_t;
+
+			[[nodiscard]] auto is_selected(std::size_t index) const noexcept -> bool;
+
+			auto select(std::size_t index) noexcept -> void;
+
+			auto deselect(std::size_t index) noexcept -> void;
+
+			auto select_none() noexcept -> void;
+
+			[[nodiscard]] auto selected_count() const noexcept -> std::size_t;
+
+			// size() if nothing is selected
+			[[nodiscard]] auto first_selected() const noexcept -> std::size_t;
+
+			// null-terminated
+			[[nodiscard]] auto name(std::size_t index) const noexcept -> std::string_view;
+
+			[[nodiscard]] auto display_name(std::size_t index) const noexcept -> const char*;
+
+			[[nodiscard]] auto extension(std::size_t index) const noexcept -> std::string_view;
+
+			// the listing is sorted by (group, sort key), directories first
+			[[nodiscard]] auto sort_key(std::size_t index) const noexcept -> std::pair<bool, std::string_view>;
+
+			// the memory used by the listing (including the unused capacity)
+			[[nodiscard]] auto bytes() const noexcept -> std::size_t;
+
+			static auto append_sort_key(std::string& key, std::string_view name, SortOrder sort_order) noexcept -> void;
+		};
+
+		// see FileBrowserFlags::ASYNC_SCAN
+		class DirectoryScanner;
+		// see FileBrowserFlags::FETCH_METADATA
+		class MetadataFetcher;
+		// see FileBrowserFlags::WATCH_DIRECTORY
+		class DirectoryWatcher;
+
+		// a cached listing is valid as long as the directory did not change
+		struct directory_stamp
+		{
+			std::int64_t last_write_time;
+			std::int64_t last_status_change_time;
+
+			[[nodiscard]] constexpr auto operator==(const directory_stamp&) const noexcept -> bool = default;
+		};
+
+		// see FileBrowserFlags::CACHE_LISTING
+		class ListingCache;
+		// see FileBrowserFlags::PREFETCH_DIRECTORIES
+		class DirectoryPrefetcher;
+		// see FileBrowserFlags::GRID_VIEW
+		class ThumbnailLoader;
+		class ThumbnailCache;
+
+		// one button of the path bar (one element of the working directory)
+		struct breadcrumb_segment
+		{
+			// offset of the label in breadcrumb::labels (null-terminated)
+			std::uint32_t label_offset;
+			// breadcrumb::path.substr(0, prefix_size) is the directory of the button
+			std::uint32_t prefix_size;
+			// the width of the label, measured with breadcrumb::font (the frame padding is not included)
+			float text_width;
+		};
+
+		// built once when the working directory changes, drawing the path bar neither walks the path nor allocates
+		struct breadcrumb
+		{
+			// the working directory, every segment is a prefix of it
+			std::string path;
+			// "label\0label\0..."
+			std::string labels;
+			std::vector<breadcrumb_segment> segments;
+
+			// the font (ImFont) the widths were measured with, the font is only known inside a frame
+			// nullptr until the widths are measured
+			const void* font;
+			float font_size;
+			// the width of the buttons that follow the segments ("#" and "*")
+			float trailing_text_width;
+			// the width of the overflow button ("...")
+			float overflow_text_width;
+
+			// the available width the layout was computed for, negative if the layout is out of date
+			float layout_width;
+			// the segments [1, first_visible) are collapsed into the overflow dropdown, 1 if nothing is collapsed
+			std::uint32_t first_visible;
+
+			[[nodiscard]] auto label(std::size_t index) const noexcept -> const char*;
+
+			[[nodiscard]] auto prefix(std::size_t index) const noexcept -> std::string_view;
 		};
 
 		std::string title_;
@@ -251,6 +718,7 @@ namespace ImGui
 		// ========================
 
 		std::filesystem::path working_directory_;
+		breadcrumb breadcrumb_;
 
 		// ========================
 		// interactive
@@ -264,7 +732,9 @@ namespace ImGui
 		// selection
 		// ========================
 
-		std::unordered_set<std::filesystem::path> selected_filenames_;
+		// the selection itself lives in file_descriptors_ (bitset)
+		// the names of the selected entries carried over a refresh, reselected once they are listed again
+		std::vector<std::pair<std::string, bool>> reselected_filenames_;
 
 		// ========================
 		// filter
@@ -273,13 +743,151 @@ namespace ImGui
 		// [0]: wildcard filter (*)
 		// [0]: combined filter
 		std::vector<std::string> filters_;
+		// parallel to filters_, compiled by set_filter
+		std::vector<FilterMatcher> filter_matchers_;
 		std::vector<std::string>::difference_type selected_filter_;
+		// bit i: file_descriptors_.extensions[i] is matched by the selected filter
+		std::vector<std::uint64_t> filter_mask_;
+		// number of extensions covered by filter_mask_
+		std::size_t filter_mask_size_;
 
 		// ========================
 		// file descriptor
 		// ========================
 
-		std::vector<file_descriptor> file_descriptors_;
+		file_listing file_descriptors_;
+		// shared with the worker thread, the worker only holds it until the enumeration is completed or cancelled
+		std::shared_ptr<DirectoryScanner> directory_scanner_;
+		// maximum number of entries loaded before the user asks for more, 0 means unlimited
+		std::size_t scan_limit_;
+		// bumped whenever file_descriptors_ is replaced (working directory changed, rescanned), the metadata of an outdated generation is dropped
+		std::uint32_t file_descriptors_generation_;
+		// bumped whenever the indices of file_descriptors_ change (including the incremental merges / watcher updates / re-sorts)
+		std::uint32_t file_descriptors_revision_;
+
+		// most significant first, file_descriptors_ itself is always sorted by name (directories first)
+		std::vector<sort_spec> sort_specs_;
+		// indices of file_descriptors_ in display order, [0] is always the parent folder
+		std::vector<std::uint32_t> file_descriptors_order_;
+		// indexed by SortColumn (only SortColumn::EXTENSION / SIZE / LAST_WRITE_TIME are used), built on first use
+		std::array<column_order, 5> column_orders_;
+		// the keys of the passes of order_file_descriptors and the scratch space of the radix sort, kept so that a re-sort does not allocate
+		std::vector<std::uint64_t> order_keys_;
+		std::vector<std::uint64_t> order_keys_buffer_;
+		std::vector<std::uint32_t> order_buffer_;
+		// the rows actually shown (file_descriptors_order_ without the filtered out entries), the list is clipped over it
+		std::vector<std::uint32_t> file_descriptors_view_;
+		// file_descriptors_view_rows_[index] is the row of the entry in file_descriptors_view_, max() if it is filtered out
+		std::vector<std::uint32_t> file_descriptors_view_rows_;
+
+		std::shared_ptr<DirectoryWatcher> directory_watcher_;
+		// the names reported by the watcher while the enumeration is incomplete (applied right away), the scanner reports them later or not at all,
+		// the entries the scanner reports for them afterwards are outdated and dropped (see drop_watched_file_descriptors)
+		std::unordered_set<std::string, transparent_string_hash, std::equal_to<>> watched_names_;
+
+		// empty if the listing cannot be cached
+		std::filesystem::path listing_cache_key_;
+		// taken before the enumeration
+		directory_stamp listing_cache_stamp_;
+
+		std::shared_ptr<DirectoryPrefetcher> directory_prefetcher_;
+		// the hovered directory is only requested once
+		std::size_t prefetch_hovered_index_;
+
+		// ========================
+		// metadata
+		// ========================
+
+		std::shared_ptr<MetadataFetcher> metadata_fetcher_;
+		// indices of the visible entries without metadata (collected while drawing the rows)
+		std::vector<std::size_t> metadata_visible_requests_;
+		// the invisible entries are requested in order once the visible ones are done
+		std::size_t metadata_sweep_cursor_;
+		// bumped whenever streamed in metadata is applied to file_descriptors_ (the column orders of SIZE / LAST_WRITE_TIME are outdated)
+		std::uint32_t file_metadata_revision_;
+		// the time taken by the last order_file_descriptors
+		std::chrono::steady_clock::duration file_descriptors_order_cost_;
+		// the streamed in metadata is applied to the order once reached, time_point{} if nothing is pending
+		std::chrono::steady_clock::time_point metadata_order_deadline_;
+
+		// ========================
+		// type-ahead
+		// ========================
+
+		std::array<char, type_ahead_capacity> type_ahead_prefix_;
+		std::size_t type_ahead_prefix_size_;
+		// ImGui::GetTime() of the last typed character
+		double type_ahead_time_;
+		// the folded prefix (see file_listing::append_sort_key), reserved once so that a keystroke does not allocate
+		std::string type_ahead_key_;
+		// the row of file_descriptors_view_ focused (nav cursor + range source of the multi-select) and scrolled into view on the next frame, -1 if none
+		int type_ahead_row_;
+
+		// ========================
+		// search (FileBrowserFlags::SEARCH_BOX)
+		// ========================
+
+		// the text of the search field
+		std::array<char, search_capacity> search_buffer_;
+		// the (lowercase) query of search_results_, reserved once
+		std::string search_query_;
+		// the listing the search index (search_names_ / search_offsets_ / search_masks_) was built for
+		std::uint32_t search_revision_;
+		std::size_t search_size_;
+		// each name followed by its lowercase copy, in the order of the listing (file_descriptors_.names is in the order of the enumeration),
+		// the candidates are scored in the order of the listing, so the names are read sequentially instead of all over the arena
+		std::string search_names_;
+		// the offset of each name in search_names_ (its lowercase copy follows it)
+		std::vector<std::uint32_t> search_offsets_;
+		// the characters of each name (one bit per letter / digit), the names missing a character of the query are never scored
+		std::vector<std::uint64_t> search_masks_;
+		// the entries matching search_query_ in the order of the listing, a refined query only rescans them
+		std::vector<std::uint32_t> search_results_;
+		// search_results_ best first, shown instead of file_descriptors_order_ while the query is not empty
+		std::vector<std::uint32_t> search_ranked_;
+		// the ranking keys of search_ranked_ and the scratch space of the radix sort, kept so that a keystroke does not allocate
+		std::vector<std::uint64_t> search_scores_;
+		std::vector<std::uint64_t> search_scores_buffer_;
+		std::vector<std::uint32_t> search_ranked_buffer_;
+
+		// ========================
+		// redraw
+		// ========================
+
+		// the mouse moved over the window, the hover delay of the tooltips elapses until then (time_point{} if nothing is hovered)
+		std::chrono::steady_clock::time_point redraw_deadline_;
+
+#if IMFB_STATISTICS
+		// ========================
+		// statistics
+		// ========================
+
+		// indexed by StatisticsPhase
+		std::array<statistics_type, statistics_phase_count> statistics_;
+
+		auto record_statistics(StatisticsPhase phase, std::chrono::nanoseconds elapsed) noexcept -> void;
+#endif
+
+		// ========================
+		// thumbnail
+		// ========================
+
+		std::shared_ptr<ThumbnailProvider> thumbnail_provider_;
+		thumbnail_upload_type thumbnail_upload_;
+		// shared with the workers, recreated when the provider or the size changes
+		std::shared_ptr<ThumbnailLoader> thumbnail_loader_;
+		// per FileBrowser, the textures belong to the host
+		std::shared_ptr<ThumbnailCache> thumbnail_cache_;
+		std::size_t thumbnail_cache_capacity_;
+		std::uint32_t thumbnail_size_;
+		// the working directory followed by a separator, the key of a thumbnail is its path
+		std::string thumbnail_directory_;
+		// reused every cell, the lookup of a cached thumbnail does not allocate
+		std::string thumbnail_key_;
+		// the first visible line of the grid, the queued requests are dropped once it changes
+		std::size_t thumbnail_first_line_;
+		// collected while drawing the cells
+		std::vector<std::pair<std::string, std::filesystem::path>> thumbnail_requests_;
 
 		// ========================
 		// tooltip
@@ -304,9 +912,20 @@ namespace ImGui
 		// filter
 		// ========================
 
-		[[nodiscard]] auto is_filter_matched(const std::filesystem::path& extension) const noexcept -> bool;
+		// the plain extensions of the selected filter
+		[[nodiscard]] auto is_filter_matched(std::string_view extension) const noexcept -> bool;
+
+		// one bit test, extension is an index in file_descriptors_.extensions
+		[[nodiscard]] auto is_filter_matched(std::uint32_t extension) const noexcept -> bool;
+
+		// the extension (one bit test) first, then the globs of the selected filter over the name, index is an index in file_descriptors_
+		[[nodiscard]] auto is_file_descriptor_matched(std::size_t index) const noexcept -> bool;
+
+		// compile the selected filter over the extensions interned since the last call
+		auto update_filter_mask() noexcept -> void;
 
-		[[nodiscard]] auto has_combined_filter() const noexcept -> bool;
+		// the filters or the extensions changed, compile the mask again
+		auto reset_filter_mask() noexcept -> void;
 
 		// ========================
 		// file descriptor
@@ -314,20 +933,156 @@ namespace ImGui
 
 		auto update_file_descriptors() noexcept -> void;
 
+		// merge the entries published by the background scanner (if any)
+		auto poll_file_descriptors() noexcept -> void;
+
+		auto cancel_file_descriptors_scanning() noexcept -> void;
+
+		// continue the enumeration paused at the scan limit
+		auto load_more_file_descriptors() noexcept -> void;
+
+		// merge the sorted entries appended after middle into the listing
+		auto merge_file_descriptors(std::size_t middle) noexcept -> void;
+
+		// drop the scanned entries appended after middle which the watcher already reported (see watched_names_)
+		auto drop_watched_file_descriptors(std::size_t middle) noexcept -> void;
+
+		// cancel the enumeration of the current working directory immediately and switch to directory next frame
+		auto change_working_directory(std::filesystem::path directory) noexcept -> void;
+
+		[[nodiscard]] auto get_sort_order() const noexcept -> SortOrder;
+
+		// rebuild the sort keys of the listing and sort it again (the sort order changed)
+		auto sort_file_descriptors() noexcept -> void;
+
+		// rebuild file_descriptors_order_ from sort_specs_ (without enumerating the directory again)
+		auto order_file_descriptors() noexcept -> void;
+
+		// the column order of SortColumn::EXTENSION / SIZE / LAST_WRITE_TIME, rebuilt only if the listing or the metadata changed since
+		[[nodiscard]] auto update_column_order(SortColumn column) noexcept -> const column_order&;
+
+		// rebuild file_descriptors_view_ from file_descriptors_order_ (flags and selected filter), only if it is outdated
+		auto update_file_descriptors_view() noexcept -> void;
+
+		// file_descriptors_ is replaced, all in-flight metadata requests are outdated
+		auto bump_file_descriptors_generation() noexcept -> void;
+
+		// the indices of file_descriptors_ changed, the in-flight metadata requests are kept (their results are found again by name)
+		auto bump_file_descriptors_revision() noexcept -> void;
+
+		// the first entry (after the parent folder path) not less than (is_directory, sort_key)
+		[[nodiscard]] auto lower_bound_file_descriptor(std::string_view sort_key, bool is_directory) const noexcept -> std::size_t;
+
+		// file_descriptors_.size() if not listed
+		[[nodiscard]] auto find_file_descriptor(std::string_view name, bool is_directory) const noexcept -> std::size_t;
+
+		// FileBrowserFlags::SEARCH_BOX and the query is not empty
+		[[nodiscard]] auto is_searching() const noexcept -> bool;
+
+		// rebuild the search index (the listing changed)
+		auto update_search_index() noexcept -> void;
+
+		// match the query of the search field against the listing, only if the query or the listing changed
+		auto update_search() noexcept -> void;
+
+		// the first visible entry (in the order of the listing) whose name starts with type_ahead_prefix_, file_descriptors_.size() if none
+		// O(log n) per probe, the prefix is folded into type_ahead_key_
+		[[nodiscard]] auto find_type_ahead_match() noexcept -> std::size_t;
+
+		// consume the characters typed into the files window (focused), select the match of the prefix, move the keyboard focus onto it and scroll it into view
+		auto update_type_ahead() noexcept -> void;
+
+		// select the entries of reselected_filenames_ listed so far (a file hidden by the selected filter is not selected)
+		auto reselect_file_descriptors() noexcept -> void;
+
+		// select (or deselect) the rows [first, last] of file_descriptors_view_, only the selectable entries are selected
+		auto select_file_descriptors_view(std::size_t first, std::size_t last, bool selected) noexcept -> void;
+
+		// apply the changes reported by the watcher (if any)
+		auto poll_directory_watcher() noexcept -> void;
+
+		// the working directory is watched, file operations do not need to rescan the directory
+		[[nodiscard]] auto is_directory_watched() const noexcept -> bool;
+
+		// rescan the working directory, unless the watcher will report the change
+		auto refresh_file_descriptors() noexcept -> void;
+
+		[[nodiscard]] auto is_listing_cached() const noexcept -> bool;
+
+		// store the complete listing into the shared cache
+		auto cache_file_descriptors() noexcept -> void;
+
+		auto prefetch_directory(const std::filesystem::path& directory) noexcept -> void;
+
+		// ========================
+		// metadata
+		// ========================
+
+		// request the visible entries first, then sweep the rest
+		auto request_file_metadata() noexcept -> void;
+
+		auto poll_file_metadata() noexcept -> void;
+
+		auto stop_file_metadata_fetching() noexcept -> void;
+
+		// ========================
+		// thumbnail
+		// ========================
+
+		// (re)create the loader and the cache, the cached thumbnails are released
+		auto reset_thumbnails() noexcept -> void;
+
+		// drop the queued requests (the requested cells are not visible anymore)
+		auto drop_thumbnail_requests() noexcept -> void;
+
+		// upload the decoded thumbnails
+		auto poll_thumbnails() noexcept -> void;
+
+		// ========================
+		// redraw
+		// ========================
+
+		// called at the end of show(), keep REDRAW_REQUIRED if the next frame will differ (pending states, active input)
+		auto update_redraw_state() noexcept -> void;
+
 		// ========================
 		// show
 		// ========================
 
+		// rebuild breadcrumb_ (the working directory changed)
+		auto update_breadcrumb() noexcept -> void;
+
+		// measure the segments (the font changed) and collapse the segments that do not fit (the available width changed)
+		auto layout_breadcrumb() noexcept -> void;
+
 		auto show_working_path() noexcept -> void;
 
 		auto show_tooltip() const noexcept -> void;
 
+		// the columns of the files table (header only table or FileBrowserFlags::TABLE_VIEW), the sort specs of the table drive file_descriptors_order_
+		auto setup_files_table() noexcept -> void;
+
+		// header only table
+		auto show_files_sort_header() noexcept -> void;
+
+		// FileBrowserFlags::TABLE_VIEW (and not FileBrowserFlags::GRID_VIEW)
+		[[nodiscard]] auto is_table_view() const noexcept -> bool;
+
+		// FileBrowserFlags::TABLE_VIEW, the columns after the name
+		auto show_file_descriptor_columns(std::size_t index) const noexcept -> void;
+
+		// FileBrowserFlags::GRID_VIEW, draw the thumbnail and the name into the cell (last item), the thumbnail is requested if it is not cached
+		auto show_file_descriptor_thumbnail(std::size_t index) noexcept -> void;
+
 		auto show_files_window_context() noexcept -> void;
 
 		auto show_files_window_context_on_creating() noexcept -> void;
 
 		auto show_files_window_context_on_renaming() noexcept -> void;
 
+		// FileBrowserFlags::SEARCH_BOX
+		auto show_search_box() noexcept -> void;
+
 		auto show_files_window() noexcept -> void;
 
 		auto show_bottom_tools() noexcept -> void;
@@ -432,8 +1187,7 @@ namespace ImGui
 			requires(std::is_same_v<T, FileBrowserFlags> and ...)
 		auto set_flags(T... flags) noexcept -> void
 		{
-			set_flags(FileBrowserFlags::NONE);
-			append_flags(flags...);
+			set_flags({flags...});
 		}
 
 		// ========================
@@ -444,6 +1198,15 @@ namespace ImGui
 
 		auto set_working_directory(const std::filesystem::path& directory = std::filesystem::current_path()) noexcept -> bool;
 
+		// ========================
+		// scan
+		// ========================
+
+		[[nodiscard]] auto get_scan_limit() const noexcept -> std::size_t;
+
+		// load at most `limit` entries of the working directory, then wait for the user to load more (0 means unlimited)
+		auto set_scan_limit(std::size_t limit) noexcept -> void;
+
 		// ========================
 		// window
 		// ========================
@@ -458,6 +1221,10 @@ namespace ImGui
 
 		auto show() noexcept -> void;
 
+		// something changed since the last show() (worker results, pending states, input over the window, setters),
+		// the host may skip the frame (sleep) as long as it returns false and no event arrived, never blocks
+		[[nodiscard]] auto needs_redraw() const noexcept -> bool;
+
 		// ========================
 		// selection
 		// ========================
@@ -468,6 +1235,14 @@ namespace ImGui
 
 		[[nodiscard]] auto get_all_selected() const noexcept -> std::vector<std::filesystem::path>;
 
+		// select the entry filename of the working directory as a click on its row would (e.g. restore the last selection after open()),
+		// the current selection is replaced but not confirmed: has_selected() stays false until the user confirms it (OK / Enter / double click)
+		// only an entry a click could select is selected: a directory with FileBrowserFlags::SELECT_DIRECTORY, a file otherwise,
+		// and a file must not be hidden by the selected filter (the search query does not matter, it does not change the selection either)
+		// nothing is selected if there is no such entry, an entry not listed yet (ASYNC_SCAN / scan limit) is selected once it is listed
+		// open() and close() clear the selection, so call it after open()
+		auto set_selected(std::string_view filename) noexcept -> void;
+
 		auto clear_selected() noexcept -> void;
 
 		// ========================
@@ -483,5 +1258,52 @@ namespace ImGui
 		auto set_filter(const std::vector<std::string>& filters) noexcept -> void;
 
 		auto clear_filter() noexcept -> void;
+
+		// ========================
+		// search
+		// ========================
+
+		// the text of the search field (FileBrowserFlags::SEARCH_BOX)
+		[[nodiscard]] auto get_search_query() const noexcept -> std::string_view;
+
+		// replace the text of the search field (truncated to search_capacity - 1 characters), the entries are matched by the next show()
+		auto set_search_query(std::string_view query) noexcept -> void;
+
+		// ========================
+		// cache
+		// ========================
+
+		// shared by all FileBrowser (FileBrowserFlags::CACHE_LISTING), the least recently used listings are evicted first
+		static auto set_listing_cache_capacity(std::size_t bytes) noexcept -> void;
+
+		static auto clear_listing_cache() noexcept -> void;
+
+		// ========================
+		// thumbnail
+		// ========================
+
+		// FileBrowserFlags::GRID_VIEW, without a provider the cells show the names only
+		auto set_thumbnail_provider(std::shared_ptr<ThumbnailProvider> provider, thumbnail_upload_type upload, thumbnail_release_type release) noexcept -> void;
+
+		[[nodiscard]] auto get_thumbnail_size() const noexcept -> std::uint32_t;
+
+		// the size of the cells (and the maximum size of the decoded images), the cached thumbnails are decoded again
+		auto set_thumbnail_size(std::uint32_t size) noexcept -> void;
+
+		// the least recently drawn thumbnails are released once the decoded pixels exceed it
+		auto set_thumbnail_cache_capacity(std::size_t bytes) noexcept -> void;
+
+#if IMFB_STATISTICS
+		// ========================
+		// statistics
+		// ========================
+
+		[[nodiscard]] auto get_statistics(StatisticsPhase phase) const noexcept -> const statistics_type&;
+
+		auto reset_statistics() noexcept -> void;
+
+		// a debug overlay with the statistics of every phase (call it outside of show())
+		auto show_statistics() noexcept -> void;
+#endif
 	};
 }
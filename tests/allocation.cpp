@@ -0,0 +1,222 @@
+// show() must not allocate once nothing changes anymore (FileBrowserFlags are tested in a few combinations, with a selection and a search query)
+// the global operator new counts the allocations of the main thread, the workers (scanner / metadata / watcher / prefetcher) are free to allocate
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <new>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <imgui.h>
+#include <imgui-file_browser.hpp>
+
+namespace
+{
+	thread_local bool g_counting = false;
+	std::size_t g_allocations = 0;
+
+	[[nodiscard]] auto allocate(const std::size_t size) -> void*
+	{
+		if (g_counting)
+		{
+			g_allocations += 1;
+		}
+
+		// malloc(0) may return nullptr
+		if (auto* pointer = std::malloc(size == 0 ? 1 : size))
+		{
+			return pointer;
+		}
+
+		throw std::bad_alloc{};
+	}
+}
+
+auto operator new(const std::size_t size) -> void*
+{
+	return allocate(size);
+}
+
+auto operator new[](const std::size_t size) -> void*
+{
+	return allocate(size);
+}
+
+auto operator delete(void* pointer) noexcept -> void
+{
+	std::free(pointer);
+}
+
+auto operator delete[](void* pointer) noexcept -> void
+{
+	std::free(pointer);
+}
+
+auto operator delete(void* pointer, std::size_t) noexcept -> void
+{
+	std::free(pointer);
+}
+
+auto operator delete[](void* pointer, std::size_t) noexcept -> void
+{
+	std::free(pointer);
+}
+
+namespace
+{
+	constexpr int warm_up_frames = 100;
+	constexpr int counted_frames = 30;
+
+	struct configuration
+	{
+		const char* name;
+		std::vector<ImGui::FileBrowserFlags> flags;
+		bool filtered;
+		// the entry selected once opened, empty: nothing is selected
+		std::string_view selected;
+		// the text of the search field (FileBrowserFlags::SEARCH_BOX)
+		std::string_view query;
+	};
+
+	auto frame(ImGui::FileBrowser& file_browser) noexcept -> void
+	{
+		ImGui::NewFrame();
+		file_browser.show();
+		ImGui::Render();
+	}
+
+	// the number of allocations of the counted frames, -1 if the entry of the configuration was not selected
+	[[nodiscard]] auto count_steady_allocations(const std::filesystem::path& directory, const configuration& configuration) -> int
+	{
+		ImGui::FileBrowser file_browser{"allocation", ImGui::FileBrowserFlags::NONE, directory};
+		for (const auto flag: configuration.flags)
+		{
+			file_browser.append_flags(flag);
+		}
+		if (configuration.filtered)
+		{
+			file_browser.set_filter(std::vector<std::string>{".png", ".md"});
+		}
+		file_browser.set_search_query(configuration.query);
+		file_browser.open();
+		// open() clears the selection
+		if (not configuration.selected.empty())
+		{
+			file_browser.set_selected(configuration.selected);
+		}
+
+		// the workers deliver their results over the next frames
+		for (int frame_index = 0; frame_index < warm_up_frames; ++frame_index)
+		{
+			frame(file_browser);
+			std::this_thread::sleep_for(std::chrono::milliseconds{1});
+		}
+
+		if (not configuration.selected.empty() and file_browser.get_selected() != directory / configuration.selected)
+		{
+			return -1;
+		}
+
+		g_allocations = 0;
+		g_counting = true;
+		for (int frame_index = 0; frame_index < counted_frames; ++frame_index)
+		{
+			frame(file_browser);
+		}
+		g_counting = false;
+
+		return static_cast<int>(g_allocations);
+	}
+}
+
+auto main() -> int
+{
+	std::error_code error_code{};
+
+	const auto directory = std::filesystem::temp_directory_path(error_code) / "imfb_test_allocation";
+	if (error_code)
+	{
+		std::printf("[FAILED] no temporary directory: %s\n", error_code.message().c_str());
+		return EXIT_FAILURE;
+	}
+
+	remove_all(directory, error_code);
+	for (const auto* name: {"textures", "scenes"})
+	{
+		if (create_directories(directory / name, error_code);
+			error_code)
+		{
+			std::printf("[FAILED] cannot create %s: %s\n", (directory / name).string().c_str(), error_code.message().c_str());
+			return EXIT_FAILURE;
+		}
+	}
+	for (const auto* name: {"albedo.png", "brick_normal.tga", "frame_2.exr", "frame_10.exr", "README.md", "scene.json", ".hidden"})
+	{
+		if (std::ofstream file{directory / name};
+			not (file << name))
+		{
+			std::printf("[FAILED] cannot create %s\n", (directory / name).string().c_str());
+			return EXIT_FAILURE;
+		}
+	}
+
+	ImGui::CreateContext();
+	{
+		auto& io = ImGui::GetIO();
+		io.IniFilename = nullptr;
+		io.DisplaySize = ImVec2{1280, 720};
+		io.DeltaTime = 1.0f / 60;
+
+		// NewFrame requires the font atlas to be built
+		unsigned char* pixels = nullptr;
+		int width = 0;
+		int height = 0;
+		io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+	}
+
+	using enum ImGui::FileBrowserFlags;
+	const configuration configurations[]
+	{
+			{.name = "NONE", .flags = {}, .filtered = false},
+			{.name = "NONE (filtered)", .flags = {}, .filtered = true},
+			{.name = "FETCH_METADATA | NATURAL_SORT", .flags = {FETCH_METADATA, NATURAL_SORT}, .filtered = true},
+			{.name = "GRID_VIEW", .flags = {GRID_VIEW}, .filtered = false},
+			{.name = "ASYNC_SCAN | WATCH_DIRECTORY | PREFETCH_DIRECTORIES", .flags = {ASYNC_SCAN, WATCH_DIRECTORY, PREFETCH_DIRECTORIES}, .filtered = false},
+			{.name = "NONE (selected)", .flags = {}, .filtered = false, .selected = "frame_10.exr"},
+			{.name = "TABLE_VIEW | FETCH_METADATA (selected)", .flags = {TABLE_VIEW, FETCH_METADATA}, .filtered = false, .selected = "albedo.png"},
+			{.name = "SEARCH_BOX (query)", .flags = {SEARCH_BOX}, .filtered = false, .query = "fr"},
+			{.name = "SEARCH_BOX | TABLE_VIEW (query, selected)", .flags = {SEARCH_BOX, TABLE_VIEW}, .filtered = true, .selected = "albedo.png", .query = "a"},
+	};
+
+	int failed = 0;
+	for (const auto& configuration: configurations)
+	{
+		if (const auto allocations = count_steady_allocations(directory, configuration);
+			allocations < 0)
+		{
+			std::printf("[FAILED] %s: %.*s is not selected\n", configuration.name, static_cast<int>(configuration.selected.size()), configuration.selected.data());
+
+			failed += 1;
+		}
+		else if (allocations != 0)
+		{
+			std::printf("[FAILED] %s: %d allocations in %d steady frames\n", configuration.name, allocations, counted_frames);
+
+			failed += 1;
+		}
+		else
+		{
+			std::printf("[PASSED] %s\n", configuration.name);
+		}
+	}
+
+	ImGui::DestroyContext();
+	remove_all(directory, error_code);
+
+	return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}